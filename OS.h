@@ -3,11 +3,15 @@
 
 #include "PCB.h"
 #include "disk.h"
+#include "replacement.h"
 
 #include <algorithm>
+#include <iomanip>
 #include <vector>
 #include <list>
 #include <map>
+#include <queue>
+#include <unordered_map>
 
 class OperatingSystem {
     public:
@@ -21,7 +25,15 @@ class OperatingSystem {
             number_of_frames(RAM_ / page_size_), 
             ready_queue(0), 
             hard_disks(number_of_hard_disks_), 
-            frames(0) {
+            frame_pid(0),
+            frame_page(0),
+            frame_timestamp(0),
+            frame_slot(0),
+            policy(new LruPolicy{}),
+            references(0),
+            hits(0),
+            evictions(0),
+            recorded_references(nullptr) {
                 
             // Creates initial process
             PCB* process_1 = new PCB{ number_of_processes };
@@ -40,17 +52,13 @@ class OperatingSystem {
             for (auto disk : hard_disks) {
                 delete disk;
             }
-            // Delete frames
-            for (auto frame : frames) {
-                delete frame;
-            }
+            delete policy;
             // Delete all PCBs
             for (auto PCB : all_processes) {
                 delete PCB.second;
             }
 
             hard_disks.clear();
-            frames.clear();
             all_processes.clear();
         }
 
@@ -96,7 +104,7 @@ class OperatingSystem {
             }
             // Otherwise process added to back of queue
             else {
-                ready_queue.push_back(pid);
+                PushToReadyQueue(pid);
             }
         }
 
@@ -114,9 +122,8 @@ class OperatingSystem {
         // Moves the process currently running in CPU to the end of the ready queue
         // Also places a new process into the CPU, if there is one in the ready queue
         void CPUToReadyQueue() {    
-            ready_queue.push_back(CPU);
-            CPU = ready_queue.front();
-            ready_queue.pop_front();
+            PushToReadyQueue(CPU);
+            CPU = PopFromReadyQueue();
         }
 
         // The process using the CPU calls wait.
@@ -147,8 +154,7 @@ class OperatingSystem {
                 else {
                     // Set process using CPU to waiting
                     cpu_process->SetWaitingState(1);
-                    CPU = ready_queue.front();
-                    ready_queue.pop_front();
+                    CPU = PopFromReadyQueue();
                     // The waiting parent process will be added back to the end of the ready queue when one of its children exits.
                 }
             }
@@ -203,10 +209,11 @@ class OperatingSystem {
 
         // Removes a process from the ready queue, if the ready queue contains the process
         void RemoveFromReadyQueue(const int pid_) {
-            auto pid_to_delete = std::find(ready_queue.begin(), ready_queue.end(), pid_);
-            // If the item is in the ready queue, removes it
-            if (pid_to_delete != ready_queue.end()) {
-                ready_queue.erase(pid_to_delete);
+            auto pid_to_delete = ready_position.find(pid_);
+            // If the item is in the ready queue, its position is indexed
+            if (pid_to_delete != ready_position.end()) {
+                ready_queue.erase(pid_to_delete->second);
+                ready_position.erase(pid_to_delete);
             }
         }
 
@@ -223,57 +230,104 @@ class OperatingSystem {
         //The enumeration of pages and frames starts from 0.
         void MemorySnapshot() {
             std::cout << "Frame   " << "Page Number     " << "pid       " << "ts" << std::endl;
-            for (unsigned int i = 0; i < frames.size(); i++) {
+            for (unsigned int i = 0; i < frame_pid.size(); i++) {
                 std::cout << "  " <<  i << "        ";
-                if (frames[i]->pid_ != 0) {
-                    std::cout << "   " << frames[i]->page_ << "          " << frames[i]->pid_ << "         " << frames[i]->timestamp_;
+                if (frame_pid[i] != 0) {
+                    std::cout << "   " << frame_page[i] << "          " << frame_pid[i] << "         " << frame_timestamp[i];
                 }
                 std::cout << std::endl;
             }
         }
 
         //The process that is currently using the CPU requests a memory operation for the logical address.
+        //Resident pages are found through a hash map. Empty frames are filled first; once memory is full the replacement policy picks the victim.
         void RequestMemoryOperation(const int & address) {
             int page = address / page_size;
-            
-            int oldest_timestamp = timestamp;
-            int index_of_oldest = -1;
-
-            // Adds frames to the vector as needed until the vector is full (size is number_of_frames). Then replaces the least recently used frame
-            // If the same process wants to access the same page, just update time stamp
-            for (unsigned int i = 0; i < frames.size(); i++) {
-                if ((frames[i]->page_ == page) && (frames[i]->pid_ == CPU)) {
-                    frames[i]->timestamp_ = timestamp;
-                    timestamp++;
-                    return;
-                }
+            references++;
+            if (recorded_references != nullptr) {
+                recorded_references->push_back(PageKey(CPU, page));
             }
 
-            // If there are empty frames, create a new frame in the vector
-            if (frames.size() < number_of_frames) {
-                Frame* new_frame = new Frame{};
-                new_frame->timestamp_ = timestamp;
-                new_frame->pid_ = CPU;
-                new_frame->page_ = page;
-                frames.push_back(new_frame);
+            // If the same process wants to access the same page, just update time stamp and tell the policy
+            auto resident = page_table.find(PageKey(CPU, page));
+            if (resident != page_table.end()) {
+                int index = resident->second;
+                frame_timestamp[index] = timestamp;
+                policy->Hit(index);
+                hits++;
+                timestamp++;
+                return;
             }
 
-            // Replace the least recently used frame's data
+            int index;
+            // Nothing fits in less than one frame
+            if (number_of_frames == 0) {
+                timestamp++;
+                return;
+            }
+            // If there are empty frames, add a new frame to the table
+            else if (frame_pid.size() < number_of_frames) {
+                index = frame_pid.size();
+                frame_pid.push_back(0);
+                frame_page.push_back(0);
+                frame_timestamp.push_back(0);
+                frame_slot.push_back(-1);
+            }
+            // Cleared frames have timestamp 0, so they are replaced before any used frame, highest index first
+            else if (!cleared_frames.empty()) {
+                index = cleared_frames.top();
+                cleared_frames.pop();
+            }
+            // Replace the data of the frame the policy chooses
             else {
-                // Find the frame with the oldest(lowest) timestamp
-                for (unsigned int i = 0; i < frames.size(); i++) {
-                    if (frames[i]->timestamp_ <= oldest_timestamp) {
-                        index_of_oldest = i;
-                        oldest_timestamp = frames[i]->timestamp_;
-                    }
+                index = policy->Victim(PageKey(CPU, page));
+                page_table.erase(PageKey(frame_pid[index], frame_page[index]));
+                auto owner = all_processes.find(frame_pid[index]);
+                if (owner != all_processes.end()) {
+                    UntrackFrame(owner->second, index);
                 }
-                frames[index_of_oldest]->page_ = page;
-                frames[index_of_oldest]->pid_ = CPU;
-                frames[index_of_oldest]->timestamp_ = timestamp;
+                evictions++;
             }
+
+            frame_page[index] = page;
+            frame_pid[index] = CPU;
+            frame_timestamp[index] = timestamp;
+            page_table[PageKey(CPU, page)] = index;
+            TrackFrame(index);
+            policy->Insert(index, PageKey(CPU, page));
             timestamp++;
         }
 
+        // Replaces the page replacement policy, LRU by default. The operating system takes ownership of the policy.
+        // Must be called before the first memory operation, since the new policy knows nothing of the pages already in memory.
+        void SetReplacementPolicy(ReplacementPolicy* policy_) {
+            delete policy;
+            policy = policy_;
+        }
+
+        // Appends the page key of every later memory operation to references, e.g. to build an OptimalPolicy for a second run of
+        // the same commands. Pass nullptr to stop recording.
+        void RecordReferences(std::vector<unsigned long long>* references_) {
+            recorded_references = references_;
+        }
+
+        // Shows how well the replacement policy has done so far: the share of memory operations that found their page in memory,
+        // and how many pages were pushed out to make room.
+        void ReplacementSnapshot() const {
+            std::cout << "Policy: " << policy->Name() << std::endl;
+            std::cout << "References: " << references << "   Hits: " << hits << "   Misses: " << references - hits
+                      << "   Evictions: " << evictions << std::endl;
+            std::cout << "Hit ratio: ";
+            if (references > 0) {
+                std::cout << std::fixed << std::setprecision(2) << 100.0 * hits / references << "%";
+                std::cout.unsetf(std::ios_base::floatfield);
+            }
+            else {
+                std::cout << "-";
+            }
+            std::cout << std::endl;
+        }
+
         // Shows which processes are currently using the hard disks and what processes are waiting to use them.
         void IOSnapshot() const {
             for (int i = 0; i < number_of_hard_disks; i++) {
@@ -311,8 +365,7 @@ class OperatingSystem {
                 CPU = 1;
             }
             else {
-                CPU = ready_queue.front();
-                ready_queue.pop_front();
+                CPU = PopFromReadyQueue();
             }
         }
 
@@ -327,12 +380,18 @@ class OperatingSystem {
             }
         }
 
-        //Checks each frame for the given process. If the process is found it is removed.
-        void RemoveFromFrames(const int & pid) {
-            for (auto itr = frames.begin(); itr != frames.end(); itr++) {
-                if ((*itr)->pid_ == pid) {
-                    (*itr)->Clear();
-                }
+        //Empties the frames holding pages of the given process. Each process keeps a list of its frames, so only those are visited.
+        void RemoveFromFrames(PCB* pcb) {
+            const std::vector<int> & owned = pcb->GetFrames();
+            while (!owned.empty()) {
+                int i = owned.back();
+                UntrackFrame(pcb, i);
+                policy->Remove(i);
+                page_table.erase(PageKey(frame_pid[i], frame_page[i]));
+                frame_pid[i] = 0;
+                frame_page[i] = 0;
+                frame_timestamp[i] = 0;
+                cleared_frames.push(i);
             }
         }
 
@@ -345,29 +404,61 @@ class OperatingSystem {
         const unsigned int RAM;
         const unsigned int number_of_frames;                  
         std::list<int> ready_queue;				// Holds the pids of processes waiting on the ready queue
+        std::unordered_map<int, std::list<int>::iterator> ready_position;  // Pid to its place on the ready queue
         std::vector<HardDisk*> hard_disks; 		// Index of the vector is the disk number (disk 0 to disk n), holding a pointer to that disk
         std::map<int, PCB*> all_processes;   	// A map of all processes; The key is the pid of the process, the value is the pointer to that process
      
-        struct Frame {
-            int timestamp_;
-            int page_;
-            int pid_;
+        // The frame table, one column per field so scans only touch the field they test. Index i of each column describes frame i.
+        // An empty frame has pid 0.
+        std::vector<int> frame_pid;
+        std::vector<int> frame_page;
+        std::vector<int> frame_timestamp;       // Time of the last access
+        std::vector<int> frame_slot;            // Position of the frame in its process's frame list, -1 if the process has no PCB
+        std::unordered_map<unsigned long long, int> page_table;    // (pid, page) to the index of the frame holding it
+        std::priority_queue<int> cleared_frames;                    // Frames emptied by RemoveFromFrames, reused highest index first
+        ReplacementPolicy* policy;                                  // Chooses the frame to replace once memory is full
+        unsigned long long references;                              // Memory operations requested
+        unsigned long long hits;                                    // Memory operations whose page was already in memory
+        unsigned long long evictions;                               // Pages replaced to make room for another
+        std::vector<unsigned long long>* recorded_references;       // Where memory operations are recorded, nullptr if they are not
+
+        // Adds a process to the back of the ready queue and indexes its position.
+        // A process is on the queue at most once; only the placeholder pids 1 and -1 can repeat, and they are never removed by pid.
+        void PushToReadyQueue(const int pid) {
+            ready_queue.push_back(pid);
+            if (ready_position.count(pid) == 0) {
+                ready_position[pid] = --ready_queue.end();
+            }
+        }
 
-            Frame() : timestamp_(0), page_(0), pid_(0) {}
-            ~Frame() {}
+        // Takes the process at the front of the ready queue off it and returns its pid.
+        int PopFromReadyQueue() {
+            int pid = ready_queue.front();
+            auto indexed = ready_position.find(pid);
+            if (indexed != ready_position.end() && indexed->second == ready_queue.begin()) {
+                ready_position.erase(indexed);
+            }
+            ready_queue.pop_front();
+            return pid;
+        }
+
+        // Adds a newly filled frame to the frame list of the process whose page it holds
+        void TrackFrame(const int index) {
+            auto owner = all_processes.find(frame_pid[index]);
+            frame_slot[index] = owner == all_processes.end() ? -1 : owner->second->AddFrame(index);
+        }
 
-            bool IsEmpty() {
-                return pid_ == 0;
+        // Takes a frame off its owner's frame list
+        void UntrackFrame(PCB* owner, const int index) {
+            if (frame_slot[index] < 0) {
+                return;
             }
-            
-            void Clear() {
-                timestamp_ = 0;
-                page_ = 0;
-                pid_ = 0;
+            int moved = owner->RemoveFrame(frame_slot[index]);
+            if (moved >= 0) {
+                frame_slot[moved] = frame_slot[index];
             }
-        };
-
-        std::vector<Frame*> frames;
+            frame_slot[index] = -1;
+        }
 
         // Deletes all children of a process, and removes them and the process pcb from all disks, frames, their queues and the ready queue.
         void DeleteChildren(PCB* pcb) {
@@ -376,10 +467,14 @@ class OperatingSystem {
                 PCB* child = (*itr);
                 if (child->HasChildren()) {
                     DeleteChildren(child);
+                    // Zombies stay in all_processes and are deleted with it
+                    if (!child->IsZombieProcess()) {
+                        delete child;
+                    }
                 }
                 else {
                     RemoveFromDisks(child->GetPid());
-                    RemoveFromFrames(child->GetPid());
+                    RemoveFromFrames(child);
                     RemoveFromReadyQueue(child->GetPid());
 
                     // Delete child from all_processes
@@ -397,7 +492,7 @@ class OperatingSystem {
             }
 
             RemoveFromDisks(pcb->GetPid());
-            RemoveFromFrames(pcb->GetPid());
+            RemoveFromFrames(pcb);
             RemoveFromReadyQueue(pcb->GetPid());
         }
 };
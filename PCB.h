@@ -1,18 +1,17 @@
 #ifndef PCB_H
 #define PCB_H
 
+#include <list>
 #include <vector>
 
 
 class PCB {
     public:
 
-        PCB(int & pid_) : pid(pid_), child_processes(0), parent_process(0), process_is_zombie(0), waiting(0) {}
+        PCB(int & pid_) : pid(pid_), child_processes(0), parent_process(0), process_is_zombie(0), waiting(0), frames(0) {}
         
+        // Children are not deleted here: every PCB is owned by the operating system's process table
         ~PCB() {
-            for (auto child : child_processes) {
-                delete child;
-            }
             ClearChildren();
         }
         
@@ -23,6 +22,7 @@ class PCB {
         // Adds a pointer to a child process of this pcb
         void AddChildProcess(PCB* child_process) {
             child_processes.push_back(child_process);
+            child_process->position_in_parent = --child_processes.end();
         }
 
         // Sets the process to waiting or not waiting
@@ -60,14 +60,10 @@ class PCB {
             return !child_processes.empty();
         }
         
-        // When called on a process, removes the given child if it is found in child_processes.
+        // When called on a process, removes the given child, which must be in child_processes.
+        // The child remembers its position in the list, so this takes constant time.
         void RemoveChild(PCB* & child) {
-            for (auto itr = child_processes.begin(); itr != child_processes.end(); itr++) {
-                if ((*itr) == child) {
-                    child_processes.erase(itr);
-                    return;
-                }
-            }
+            child_processes.erase(child->position_in_parent);
         }
 
         // Sets the parent pid of a process
@@ -81,22 +77,43 @@ class PCB {
         }
 
         // Returns a constant reference to the vector of child processes.
-        const std::vector<PCB*> & GetChildren() const {
+        const std::list<PCB*> & GetChildren() const {
             return child_processes;
         }
 
-        // Clears the vector of child processes.
+        // Clears the list of child processes.
         void ClearChildren() {
             child_processes.clear();
         }
+
+        // Records that frame holds one of this process's pages. Returns the frame's slot in the frame list, needed to remove it.
+        int AddFrame(const int frame) {
+            frames.push_back(frame);
+            return frames.size() - 1;
+        }
+
+        // Removes the frame in the given slot by moving the last frame into it. Returns the frame that moved, or -1 if none did.
+        int RemoveFrame(const int slot) {
+            int moved = frames.back();
+            frames[slot] = moved;
+            frames.pop_back();
+            return slot < static_cast<int>(frames.size()) ? moved : -1;
+        }
+
+        // Returns the frames holding this process's pages, in no particular order.
+        const std::vector<int> & GetFrames() const {
+            return frames;
+        }
         
         
     private:
         int pid;                                // Unique id of the process
-        std::vector<PCB*> child_processes;      // Pointers of all children of the process
+        std::list<PCB*> child_processes;        // Pointers of all children of the process
         int parent_process;                     // The pid of the parent of the process
         bool process_is_zombie;                 // True is process is a zombie process, false otherwise
         bool waiting;                           // True if this process is waiting for a child process to terminate.
+        std::list<PCB*>::iterator position_in_parent;   // Where this process is on its parent's list of children
+        std::vector<int> frames;                // Indices of the frames holding pages of this process
 };
 
 #endif // PCB_H
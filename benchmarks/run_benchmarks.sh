@@ -1,6 +1,7 @@
 #!/bin/bash
 
 BINARY="../build/cpu-scheduler"
+BENCH="../build/scheduler-bench"
 
 echo "Running CPU Scheduler Benchmarks"
 echo "==============================="
@@ -18,4 +19,9 @@ for scenario in mixed_load heavy_load io_intensive; do
             $BINARY -a $algo -w scenarios.json --scenario $scenario
         fi
     done
-done 
\ No newline at end of file
+done
+
+echo -e "\nMeasuring scheduler and simulator speed"
+echo "======================================="
+$BENCH --benchmark_out=bench_results.json --benchmark_out_format=json
+echo "Results written to bench_results.json"
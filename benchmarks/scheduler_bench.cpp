@@ -0,0 +1,206 @@
+#include <benchmark/benchmark.h>
+#include "core/simulator.hpp"
+#include "algorithms/round_robin.hpp"
+#include "algorithms/fcfs.hpp"
+#include "algorithms/sjf.hpp"
+#include "algorithms/priority.hpp"
+#include "algorithms/work_stealing.hpp"
+#include "algorithms/cfs.hpp"
+#include "algorithms/mlfq.hpp"
+#include "core/binary_trace.hpp"
+#include "core/workload_io.hpp"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cpu_scheduler;
+
+namespace {
+
+struct RR { static auto make() { return std::make_unique<RoundRobinScheduler>(4); } };
+struct FCFS { static auto make() { return std::make_unique<FCFSScheduler>(); } };
+struct SJF { static auto make() { return std::make_unique<SJFScheduler>(); } };
+struct SRTF { static auto make() { return std::make_unique<SJFScheduler>(true); } };
+struct Prio { static auto make() { return std::make_unique<PriorityScheduler>(true); } };
+struct PrioAging { static auto make() { return std::make_unique<PriorityScheduler>(true, 10); } };
+struct WS { static auto make() { return std::make_unique<WorkStealingScheduler>(4); } };
+struct CFS { static auto make() { return std::make_unique<CFSScheduler>(); } };
+struct MLFQ { static auto make() { return std::make_unique<MLFQScheduler>(); } };
+
+// Fixed seed so every run and every release measures the same population
+ProcessTable make_processes(int64_t count) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> burst(1, 100), prio(0, 9);
+    ProcessTable processes;
+    processes.reserve(count);
+    for (int64_t i = 0; i < count; i++) {
+        processes.add(static_cast<int>(i + 1), 0, burst(rng), prio(rng));
+    }
+    return processes;
+}
+
+template <typename Algo>
+auto make_scheduler(ProcessTable& processes) {
+    auto scheduler = Algo::make();
+    scheduler->attach(processes);
+    return scheduler;
+}
+
+template <typename Algo>
+void BM_AddProcess(benchmark::State& state) {
+    auto processes = make_processes(state.range(0));
+    for (auto _ : state) {
+        auto scheduler = make_scheduler<Algo>(processes);
+        for (ProcessHandle h = 0; h < processes.size(); h++) {
+            scheduler->add_process(h);
+        }
+        benchmark::DoNotOptimize(scheduler->ready_queue_size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Algo>
+void BM_GetNextProcess(benchmark::State& state) {
+    auto processes = make_processes(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto scheduler = make_scheduler<Algo>(processes);
+        for (ProcessHandle h = 0; h < processes.size(); h++) {
+            scheduler->add_process(h);
+        }
+        state.ResumeTiming();
+        while (auto next = scheduler->get_next_process()) {
+            benchmark::DoNotOptimize(next);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Steady state: dispatch the head of a queue of range(0) processes and preempt it back
+template <typename Algo>
+void BM_PreemptProcess(benchmark::State& state) {
+    auto processes = make_processes(state.range(0));
+    auto scheduler = make_scheduler<Algo>(processes);
+    for (ProcessHandle h = 0; h < processes.size(); h++) {
+        scheduler->add_process(h);
+    }
+    for (auto _ : state) {
+        auto next = scheduler->get_next_process();
+        scheduler->preempt_process(*next);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Algo>
+void BM_SimulatorRun(benchmark::State& state) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> gap(0, 20), burst(1, 100), prio(0, 9);
+    std::vector<std::tuple<int, int, int>> workload;
+    for (int64_t i = 0, at = 0; i < state.range(0); i++) {
+        at += gap(rng);
+        workload.emplace_back(static_cast<int>(at), burst(rng), prio(rng));
+    }
+
+    for (auto _ : state) {
+        Simulator sim(Algo::make(), 1);
+        for (const auto& [arrival, burst_time, priority] : workload) {
+            sim.add_process(arrival, burst_time, priority);
+        }
+        auto stats = sim.run();
+        benchmark::DoNotOptimize(stats);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Time to get range(0) processes from disk into a simulator, JSON versus binary trace
+Workload make_workload(int64_t count) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> gap(0, 20), burst(1, 100), prio(0, 9);
+    Workload workload;
+    for (int64_t i = 0, at = 0; i < count; i++) {
+        at += gap(rng);
+        workload.push_back({static_cast<int>(at), burst(rng), prio(rng)});
+    }
+    return workload;
+}
+
+void BM_LoadJsonWorkload(benchmark::State& state) {
+    const std::string path = "scheduler_bench_load.json";
+    {
+        std::ofstream out(path);
+        out << "{\"processes\": [";
+        const char* separator = "";
+        for (const auto& e : make_workload(state.range(0))) {
+            out << separator << "{\"arrival_time\": " << e.arrival_time << ", \"burst_time\": "
+                << e.burst_time << ", \"priority\": " << e.priority << "}";
+            separator = ",";
+        }
+        out << "]}";
+    }
+    for (auto _ : state) {
+        Simulator sim(std::make_unique<FCFSScheduler>());
+        std::ifstream in(path);
+        read_workload(in, [&sim](const WorkloadEntry& e) {
+            sim.add_process(e.arrival_time, e.burst_time, e.priority);
+        });
+        benchmark::ClobberMemory();
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_LoadBinaryTrace(benchmark::State& state) {
+    const std::string path = "scheduler_bench_load.bin";
+    write_binary_trace(path, make_workload(state.range(0)));
+    for (auto _ : state) {
+        Simulator sim(std::make_unique<FCFSScheduler>());
+        MappedTrace trace(path);
+        sim.add_processes(trace.records(), trace.size());
+        benchmark::ClobberMemory();
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_LoadJsonWorkload)->RangeMultiplier(100)->Range(100, 1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadBinaryTrace)->RangeMultiplier(100)->Range(100, 1000000)
+    ->Unit(benchmark::kMillisecond);
+
+#define SCHEDULER_BENCHMARKS(Algo)                                                    \
+    BENCHMARK_TEMPLATE(BM_AddProcess, Algo)->RangeMultiplier(10)->Range(10, 100000);     \
+    BENCHMARK_TEMPLATE(BM_GetNextProcess, Algo)->RangeMultiplier(10)->Range(10, 100000); \
+    BENCHMARK_TEMPLATE(BM_PreemptProcess, Algo)->RangeMultiplier(10)->Range(10, 100000); \
+    BENCHMARK_TEMPLATE(BM_SimulatorRun, Algo)                                         \
+        ->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMillisecond)
+
+SCHEDULER_BENCHMARKS(RR);
+SCHEDULER_BENCHMARKS(FCFS);
+SCHEDULER_BENCHMARKS(SJF);
+SCHEDULER_BENCHMARKS(SRTF);
+SCHEDULER_BENCHMARKS(Prio);
+SCHEDULER_BENCHMARKS(PrioAging);
+SCHEDULER_BENCHMARKS(WS);
+SCHEDULER_BENCHMARKS(CFS);
+SCHEDULER_BENCHMARKS(MLFQ);
+
+} // namespace
+
+// Report JSON by default so results can be diffed between releases; an explicit
+// --benchmark_format later on the command line still wins
+int main(int argc, char** argv) {
+    std::string json_format = "--benchmark_format=json";
+    std::vector<char*> args(argv, argv + argc);
+    args.insert(args.begin() + 1, json_format.data());
+    int args_count = static_cast<int>(args.size());
+
+    benchmark::Initialize(&args_count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(args_count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
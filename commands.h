@@ -0,0 +1,315 @@
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include "OS.h"
+
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Skips spaces and tabs
+inline void SkipBlanks(const char* & position, const char* end) {
+    while (position < end && (*position == ' ' || *position == '\t')) {
+        position++;
+    }
+}
+
+// Reads the next word, up to a space, tab or the end of the line
+inline void NextWord(const char* & position, const char* end, const char* & word, const char* & word_end) {
+    SkipBlanks(position, end);
+    word = position;
+    while (position < end && *position != ' ' && *position != '\t') {
+        position++;
+    }
+    word_end = position;
+}
+
+// Reads the next integer. Like std::istream, gives 0 if there is none.
+inline long long NextNumber(const char* & position, const char* end) {
+    SkipBlanks(position, end);
+    bool negative = false;
+    if (position < end && (*position == '-' || *position == '+')) {
+        negative = *position == '-';
+        position++;
+    }
+    long long value = 0;
+    while (position < end && *position >= '0' && *position <= '9') {
+        if (value <= LLONG_MAX / 100) {
+            value = value * 10 + (*position - '0');
+        }
+        position++;
+    }
+    return negative ? -value : value;
+}
+
+inline int ClampToInt(const long long value) {
+    return value > INT_MAX ? INT_MAX : value < INT_MIN ? INT_MIN : static_cast<int>(value);
+}
+
+// Returns true if the line is exactly the given command
+inline bool IsCommand(const char* line, const char* end, const char* command) {
+    size_t length = std::strlen(command);
+    return static_cast<size_t>(end - line) == length && std::memcmp(line, command, length) == 0;
+}
+
+// Carries out one line of input. Lines are matched in place, so only "d", which names a file, allocates.
+// Snapshot commands are skipped unless snapshots is true. Unknown commands are ignored.
+inline void ExecuteCommand(OperatingSystem & OS, const char* line, const char* end, const bool snapshots) {
+    // Scripts written on Windows end their lines with \r\n
+    if (end > line && end[-1] == '\r') {
+        end--;
+    }
+
+    if (line < end && line[0] == 'S') {
+        if (!snapshots) {
+            return;
+        }
+        //Shows which process is currently using the CPU and which processes are waiting in the ready-queue.
+        if (IsCommand(line, end, "S r")) {
+            OS.Snapshot();
+        }
+        //Shows which processes are currently using the hard disks and which processes are waiting to use them
+        else if (IsCommand(line, end, "S i")) {
+            OS.IOSnapshot();
+        }
+        //Shows the state of memory.
+        else if (IsCommand(line, end, "S m")) {
+            OS.MemorySnapshot();
+        }
+        //Shows the hit ratio and evictions of the page replacement policy.
+        else if (IsCommand(line, end, "S p")) {
+            OS.ReplacementSnapshot();
+        }
+        return;
+    }
+    // Creates a new pcb and places it at end of ready queue, or in the CPU if the ready queue is empty.
+    if (IsCommand(line, end, "A")) {
+        OS.CreateProcess();
+        return;
+    }
+    //The currently running process has spent a time quantum using the CPU.
+    if (IsCommand(line, end, "Q")) {
+        OS.CPUToReadyQueue();
+        return;
+    }
+    //The process using the CPU forks a child.The child is placed in the end of the ready - queue.
+    if (IsCommand(line, end, "fork")) {
+        OS.Fork();
+        return;
+    }
+    //The process that is currently using the CPU terminates.
+    if (IsCommand(line, end, "exit")) {
+        OS.Exit();
+        return;
+    }
+    //The process wants to pause and wait for any of its child processes to terminate.
+    if (IsCommand(line, end, "wait")) {
+        OS.Wait();
+        return;
+    }
+
+    // For other commands, parse the words of the line
+    const char* position = line;
+    const char* word;
+    const char* word_end;
+    NextWord(position, end, word, word_end);
+    if (word_end - word != 1 || (*word != 'd' && *word != 'D' && *word != 'm')) {
+        return;
+    }
+    int number = ClampToInt(NextNumber(position, end));
+
+    //The process that currently uses the CPU requests the hard disk #number.
+    //It wants to read or write file file _name.
+    if (*word == 'd') {
+        const char* file_name;
+        const char* file_name_end;
+        NextWord(position, end, file_name, file_name_end);
+        OS.RequestDisk(number, std::string(file_name, file_name_end));
+    }
+    // The hard disk #number has finished the work for one process.
+    else if (*word == 'D') {
+        OS.RemoveProcessFromDisk(number);
+    }
+    //The process that is currently using the CPU requests a memory operation for the logical address.
+    else {
+        OS.RequestMemoryOperation(number);
+    }
+}
+
+// A command script mapped into memory and read a line at a time, in place.
+// The script has the same form as the interactive input: the amount of RAM, the page size and the number of hard disks,
+// followed by one command per line.
+class CommandScript {
+    public:
+        CommandScript() : data(nullptr), size(0), position(nullptr), end(nullptr) {}
+
+        ~CommandScript() {
+            if (data != nullptr) {
+                munmap(data, size);
+            }
+        }
+
+        // Maps the file. Returns false if it cannot be opened or mapped.
+        bool Open(const char* file_name) {
+            int descriptor = open(file_name, O_RDONLY);
+            if (descriptor < 0) {
+                return false;
+            }
+            struct stat status;
+            bool mapped = fstat(descriptor, &status) == 0;
+            size = mapped ? status.st_size : 0;
+            // An empty file cannot be mapped, but is a valid, empty script
+            if (mapped && size > 0) {
+                data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                mapped = data != MAP_FAILED;
+                if (!mapped) {
+                    data = nullptr;
+                }
+                else {
+                    madvise(data, size, MADV_SEQUENTIAL);
+                }
+            }
+            close(descriptor);
+            position = static_cast<const char*>(data);
+            end = position + (data == nullptr ? 0 : size);
+            return mapped;
+        }
+
+        // Reads the next whitespace separated number, for the answers to the start-up questions
+        long long NextNumber() {
+            while (position < end && (*position == ' ' || *position == '\t' || *position == '\n' || *position == '\r')) {
+                position++;
+            }
+            return ::NextNumber(position, end);
+        }
+
+        // Gives the rest of the current line, without its newline, and moves to the next. Returns false at the end of the script.
+        bool NextLine(const char* & line, const char* & line_end) {
+            if (position >= end) {
+                return false;
+            }
+            line = position;
+            const char* newline = static_cast<const char*>(std::memchr(position, '\n', end - position));
+            line_end = newline == nullptr ? end : newline;
+            position = newline == nullptr ? end : newline + 1;
+            return true;
+        }
+
+    private:
+        void* data;
+        size_t size;
+        const char* position;
+        const char* end;
+};
+
+// Collects output in a large buffer and writes it out only when the buffer is full or destroyed.
+// The operating system ends its lines with std::endl; the flush that comes with it is ignored.
+class BufferedOutput : public std::streambuf {
+    public:
+        explicit BufferedOutput(std::streambuf* target_) : target(target_), buffer(1 << 16) {
+            setp(&buffer[0], &buffer[0] + buffer.size());
+        }
+
+        ~BufferedOutput() {
+            Drain();
+        }
+
+        // Writes the buffered output to the target
+        void Drain() {
+            target->sputn(pbase(), pptr() - pbase());
+            target->pubsync();
+            setp(&buffer[0], &buffer[0] + buffer.size());
+        }
+
+    protected:
+        int overflow(int c) {
+            Drain();
+            if (c != traits_type::eof()) {
+                *pptr() = static_cast<char>(c);
+                pbump(1);
+            }
+            return traits_type::not_eof(c);
+        }
+
+        int sync() {
+            return 0;
+        }
+
+    private:
+        std::streambuf* target;
+        std::vector<char> buffer;
+};
+
+// Discards everything written to it
+class NullOutput : public std::streambuf {
+    protected:
+        int overflow(int c) {
+            return traits_type::not_eof(c);
+        }
+};
+
+// Runs every command of the script without prompts, stopping at its end. Snapshot commands are skipped unless snapshots is true.
+// policy is lru, clock, 2q, arc or opt. OPT needs the whole reference string, so for it the script is run twice: first with LRU
+// and no output, to record the pages referenced, then with OPT.
+// Returns 0 on success, or 1 if the script cannot be read or the policy is unknown.
+inline int RunBatch(const char* file_name, const std::string & policy_name, const bool snapshots) {
+    std::vector<unsigned long long> reference_string;
+    const bool optimal = policy_name == "opt";
+
+    for (int run = optimal ? 0 : 1; run < 2; run++) {
+        CommandScript script;
+        if (!script.Open(file_name)) {
+            std::cerr << "Cannot read the command script " << file_name << std::endl;
+            return 1;
+        }
+
+        unsigned int RAM = static_cast<unsigned int>(script.NextNumber());
+        unsigned int page_size = static_cast<unsigned int>(script.NextNumber());
+        int number_of_hard_disks = ClampToInt(script.NextNumber());
+        if (page_size == 0) {
+            std::cerr << "The page size must be positive" << std::endl;
+            return 1;
+        }
+        const char* line;
+        const char* line_end;
+        // The rest of the line holding the number of hard disks
+        script.NextLine(line, line_end);
+
+        OperatingSystem OS(number_of_hard_disks, RAM, page_size);
+        if (run == 0) {
+            OS.RecordReferences(&reference_string);
+        }
+        else if (optimal) {
+            OS.SetReplacementPolicy(new OptimalPolicy{ reference_string });
+        }
+        else {
+            ReplacementPolicy* policy = MakeReplacementPolicy(policy_name, RAM / page_size);
+            if (policy == nullptr) {
+                std::cerr << "Unknown page replacement policy " << policy_name << "; choose lru, clock, 2q, arc or opt" << std::endl;
+                return 1;
+            }
+            OS.SetReplacementPolicy(policy);
+        }
+
+        std::streambuf* console = std::cout.rdbuf();
+        NullOutput discard;
+        BufferedOutput buffered(console);
+        std::cout.rdbuf(run == 0 ? static_cast<std::streambuf*>(&discard) : &buffered);
+        while (script.NextLine(line, line_end)) {
+            ExecuteCommand(OS, line, line_end, snapshots && run == 1);
+        }
+        buffered.Drain();
+        std::cout.rdbuf(console);
+    }
+    return 0;
+}
+
+#endif // COMMANDS_H
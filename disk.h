@@ -3,6 +3,7 @@
 
 #include <list>
 #include <string>
+#include <unordered_map>
 
 class HardDisk {
     public:
@@ -20,6 +21,10 @@ class HardDisk {
             // Otherwise add the process to the io queue
             else {
                 io_queue.push_back(std::pair<int, std::string>(pid, file_name));
+                // A process waits for one disk at a time, so it is at most once on the queue
+                if (queue_position.count(pid) == 0) {
+                    queue_position[pid] = --io_queue.end();
+                }
             }
         }
 
@@ -38,6 +43,10 @@ class HardDisk {
                 else {
                     current_process = io_queue.front().first;
                     current_file = io_queue.front().second;
+                    auto indexed = queue_position.find(current_process);
+                    if (indexed != queue_position.end() && indexed->second == io_queue.begin()) {
+                        queue_position.erase(indexed);
+                    }
                     io_queue.pop_front();
                 }
             }
@@ -50,11 +59,11 @@ class HardDisk {
             if (current_process == pid) {
                 RemoveProcess();
             }
-            // If the process is in the io queue
-            for (auto itr = io_queue.begin(); itr != io_queue.end(); itr++) {
-                if ((*itr).first == pid) {
-                    io_queue.erase(itr);
-                }
+            // If the process is in the io queue, its position is indexed
+            auto indexed = queue_position.find(pid);
+            if (indexed != queue_position.end()) {
+                io_queue.erase(indexed->second);
+                queue_position.erase(indexed);
             }
         }
 
@@ -90,6 +99,7 @@ class HardDisk {
         int current_process;                                    // Pid of the process currently using the hard disk. Set to -1 when idle
         std::string current_file;                               // The name of the file the current process is reading/writing
         std::list<std::pair<int, std::string>> io_queue;        // The pids of processes waiting to use the CPU, and the names of the files associated with them
+        std::unordered_map<int, std::list<std::pair<int, std::string>>::iterator> queue_position;  // Pid to its entry on the io queue
 };
 
 #endif // DISK_H
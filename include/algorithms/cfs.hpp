@@ -0,0 +1,176 @@
+#pragma once
+
+#include "core/scheduler.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Completely Fair Scheduler modeled on Linux CFS
+ *
+ * Ready processes sit in a red-black tree (std::set) ordered by virtual runtime, the time
+ * they have executed scaled by their weight, so picking the process that is furthest
+ * behind is O(1) and queueing one is O(log n). Process::priority() is used as the nice
+ * value (-20 to 19, lower is heavier) with the kernel's weight table.
+ *
+ * Each dispatch gets a slice of the scheduling period in proportion to its weight, where
+ * the period is the target latency, stretched so no slice drops below the minimum
+ * granularity. A process runs until its slice is used up and is only preempted if
+ * another process is waiting. New arrivals start at the queue's minimum virtual runtime
+ * so they cannot monopolize the CPU by having no history.
+ */
+class CFSScheduler : public Scheduler {
+public:
+    static constexpr int kDefaultTargetLatency = 6;
+    static constexpr int kDefaultMinGranularity = 1;
+
+    explicit CFSScheduler(int target_latency = kDefaultTargetLatency,
+                          int min_granularity = kDefaultMinGranularity)
+        : target_latency_(std::max(target_latency, 1)),
+          min_granularity_(std::max(min_granularity, 1)) {}
+
+    void add_process(ProcessHandle handle) override {
+        if (handle >= vruntime_.size()) {
+            vruntime_.resize(handle + 1, 0);
+            ran_.resize(handle + 1, 0);
+            slice_.resize(handle + 1, 0);
+        }
+        vruntime_[handle] = min_vruntime_;
+        enqueue(handle);
+    }
+
+    std::optional<ProcessHandle> get_next_process() override {
+        if (timeline_.empty()) {
+            return std::nullopt;
+        }
+
+        auto leftmost = timeline_.begin();
+        ProcessHandle next = leftmost->process;
+        timeline_.erase(leftmost);
+        uint64_t weight = weight_of(next);
+        queued_weight_ -= weight;
+        min_vruntime_ = std::max(min_vruntime_, vruntime_[next]);
+
+        // Share of the period in proportion to weight, counting the dispatched process
+        long long running = static_cast<long long>(timeline_.size()) + 1;
+        long long period = std::max<long long>(target_latency_, running * min_granularity_);
+        long long slice = period * static_cast<long long>(weight) /
+                          static_cast<long long>(queued_weight_ + weight);
+        slice_[next] = static_cast<int>(std::max<long long>(slice, min_granularity_));
+        ran_[next] = 0;
+
+        process(next).set_state(Process::ProcessState::RUNNING);
+        return next;
+    }
+
+    void preempt_process(ProcessHandle current_process) override {
+        if (process(current_process).remaining_time() > 0) {
+            enqueue(current_process);
+        }
+        ran_[current_process] = 0;
+    }
+
+    bool needs_preemption(ProcessHandle current_process, int) override {
+        if (process(current_process).remaining_time() <= 0) {
+            return true;
+        }
+        charge(current_process, 1);
+        return !timeline_.empty() && ran_[current_process] >= slice_[current_process];
+    }
+
+    int ticks_until_preemption(ProcessHandle current_process, int) const override {
+        if (process(current_process).remaining_time() <= 0) {
+            return 0;
+        }
+        if (timeline_.empty()) {
+            return std::numeric_limits<int>::max();
+        }
+        return std::max(0, slice_[current_process] - ran_[current_process] - 1);
+    }
+
+    void skip_ticks(ProcessHandle current_process, int ticks) override {
+        charge(current_process, ticks);
+    }
+
+    std::string name() const override {
+        return "CFS (latency=" + std::to_string(target_latency_) +
+               ", min_gran=" + std::to_string(min_granularity_) + ")";
+    }
+
+    int target_latency() const { return target_latency_; }
+    int min_granularity() const { return min_granularity_; }
+    size_t ready_queue_size() const { return timeline_.size(); }
+    uint64_t vruntime(ProcessHandle handle) const { return vruntime_[handle]; }
+
+    /**
+     * @brief Load weight of a nice value, from the Linux sched_prio_to_weight table
+     */
+    static uint64_t nice_to_weight(int nice) {
+        static constexpr std::array<uint64_t, 40> kWeights = {
+            88761, 71755, 56483, 46273, 36291,  // -20 .. -16
+            29154, 23254, 18705, 14949, 11916,  // -15 .. -11
+             9548,  7620,  6100,  4904,  3906,  // -10 ..  -6
+             3121,  2501,  1991,  1586,  1277,  //  -5 ..  -1
+             1024,   820,   655,   526,   423,  //   0 ..   4
+              335,   272,   215,   172,   137,  //   5 ..   9
+              110,    87,    70,    56,    45,  //  10 ..  14
+               36,    29,    23,    18,    15,  //  15 ..  19
+        };
+        return kWeights[std::clamp(nice, -20, 19) + 20];
+    }
+
+private:
+    // Virtual runtime is kept in 1/1024ths of a tick so light weights do not round to 0
+    static constexpr uint64_t kNice0Weight = 1024;
+    static constexpr int kVruntimeShift = 10;
+
+    struct Entry {
+        uint64_t vruntime;
+        uint64_t seq;  // Insertion order, breaks ties FIFO
+        ProcessHandle process;
+
+        bool operator<(const Entry& other) const {
+            return vruntime != other.vruntime ? vruntime < other.vruntime : seq < other.seq;
+        }
+    };
+
+    uint64_t weight_of(ProcessHandle handle) const {
+        return nice_to_weight(process(handle).priority());
+    }
+
+    void enqueue(ProcessHandle handle) {
+        process(handle).set_state(Process::ProcessState::READY);
+        timeline_.insert(Entry{vruntime_[handle], next_seq_++, handle});
+        queued_weight_ += weight_of(handle);
+    }
+
+    void charge(ProcessHandle handle, int ticks) {
+        ran_[handle] += ticks;
+        vruntime_[handle] += static_cast<uint64_t>(ticks) *
+                             ((kNice0Weight << kVruntimeShift) / weight_of(handle));
+
+        // Track the running process as well as the queue, so a process arriving while one
+        // has been running alone starts level with it rather than far behind
+        uint64_t floor = vruntime_[handle];
+        if (!timeline_.empty()) {
+            floor = std::min(floor, timeline_.begin()->vruntime);
+        }
+        min_vruntime_ = std::max(min_vruntime_, floor);
+    }
+
+    int target_latency_;
+    int min_granularity_;
+    std::set<Entry> timeline_;        // Ready processes, leftmost is furthest behind
+    uint64_t queued_weight_{0};       // Sum of weights in timeline_
+    uint64_t min_vruntime_{0};        // Never decreases; where new arrivals start
+    uint64_t next_seq_{0};
+    std::vector<uint64_t> vruntime_;  // Indexed by process handle
+    std::vector<int> ran_;            // Ticks executed since dispatch
+    std::vector<int> slice_;          // Ticks granted at dispatch
+};
+
+} // namespace cpu_scheduler
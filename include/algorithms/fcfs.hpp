@@ -15,33 +15,36 @@ class FCFSScheduler : public Scheduler {
 public:
     FCFSScheduler() = default;
 
-    void add_process(std::shared_ptr<Process> process) override {
-        processes_[process->pid()] = process;
-        process->set_state(Process::ProcessState::READY);
-        ready_queue_.push(process);
+    void add_process(ProcessHandle handle) override {
+        process(handle).set_state(Process::ProcessState::READY);
+        ready_queue_.push(handle);
     }
 
-    std::optional<std::shared_ptr<Process>> get_next_process() override {
+    std::optional<ProcessHandle> get_next_process() override {
         if (ready_queue_.empty()) {
             return std::nullopt;
         }
         auto next = ready_queue_.front();
         ready_queue_.pop();
-        next->set_state(Process::ProcessState::RUNNING);
+        process(next).set_state(Process::ProcessState::RUNNING);
         return next;
     }
 
-    void preempt_process(std::shared_ptr<Process> current_process) override {
-        if (current_process && current_process->remaining_time() > 0) {
-            current_process->set_state(Process::ProcessState::READY);
+    void preempt_process(ProcessHandle current_process) override {
+        if (process(current_process).remaining_time() > 0) {
+            process(current_process).set_state(Process::ProcessState::READY);
             ready_queue_.push(current_process);
         }
     }
 
-    bool needs_preemption(std::shared_ptr<Process>, int) override {
+    bool needs_preemption(ProcessHandle, int) override {
         return false;  // FCFS is non-preemptive
     }
 
+    int ticks_until_preemption(ProcessHandle, int) const override {
+        return std::numeric_limits<int>::max();
+    }
+
     std::string name() const override {
         return "First Come First Serve";
     }
@@ -51,7 +54,7 @@ public:
     }
 
 private:
-    std::queue<std::shared_ptr<Process>> ready_queue_;
+    std::queue<ProcessHandle> ready_queue_;
 };
 
 } // namespace cpu_scheduler 
\ No newline at end of file
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "core/scheduler.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Multilevel Feedback Queue scheduling algorithm implementation
+ *
+ * Processes enter at level 0, the highest priority, and each level is a FIFO run with its
+ * own quantum, doubling from the base quantum at every level down. A process that uses
+ * up its quantum at a level, over however many dispatches, is demoted one level. A
+ * process waiting at a higher level preempts the running one. Every boost interval all
+ * processes are moved back to level 0 so long-running ones cannot starve; the boost is
+ * applied at the first preemption check at or after each interval.
+ *
+ * A bitmap records which levels are non-empty, so finding the highest one is a single
+ * find-first-set instruction no matter how many processes are queued, as in the Linux
+ * O(1) scheduler.
+ */
+class MLFQScheduler : public Scheduler {
+public:
+    static constexpr int kMaxLevels = 64;
+
+    /**
+     * @param levels Number of priority levels, at most kMaxLevels
+     * @param base_quantum Quantum at level 0; level i gets base_quantum << i
+     * @param boost_interval Time between boosts to level 0, or 0 to never boost
+     */
+    explicit MLFQScheduler(int levels = 3, int base_quantum = 4, int boost_interval = 100)
+        : levels_(std::clamp(levels, 1, kMaxLevels)),
+          boost_interval_(std::max(boost_interval, 0)),
+          next_boost_(boost_interval_ > 0 ? boost_interval_
+                                          : std::numeric_limits<long long>::max()),
+          queues_(levels_) {
+        for (int level = 0; level < levels_; level++) {
+            // Saturate rather than overflow on deep hierarchies
+            long long quantum = static_cast<long long>(std::max(base_quantum, 1))
+                                << std::min(level, 30);
+            quanta_.push_back(static_cast<int>(
+                std::min<long long>(quantum, std::numeric_limits<int>::max())));
+        }
+    }
+
+    void add_process(ProcessHandle handle) override {
+        if (handle >= level_.size()) {
+            level_.resize(handle + 1, 0);
+            used_.resize(handle + 1, 0);
+            epoch_.resize(handle + 1, 0);
+        }
+        level_[handle] = 0;
+        used_[handle] = 0;
+        epoch_[handle] = boost_epoch_;
+        enqueue(handle);
+    }
+
+    std::optional<ProcessHandle> get_next_process() override {
+        if (nonempty_ == 0) {
+            return std::nullopt;
+        }
+
+        int level = lowest_set_bit(nonempty_);
+        auto& queue = queues_[level];
+        auto next = queue.front();
+        queue.pop_front();
+        if (queue.empty()) {
+            nonempty_ &= ~(uint64_t{1} << level);
+        }
+        queued_--;
+        catch_up_boost(next);
+        process(next).set_state(Process::ProcessState::RUNNING);
+        return next;
+    }
+
+    void preempt_process(ProcessHandle current_process) override {
+        if (used_[current_process] >= quanta_[level_[current_process]]) {
+            level_[current_process] = std::min(level_[current_process] + 1, levels_ - 1);
+            used_[current_process] = 0;
+        }
+        if (process(current_process).remaining_time() > 0) {
+            enqueue(current_process);
+        }
+    }
+
+    bool needs_preemption(ProcessHandle current_process, int current_time) override {
+        if (current_time >= next_boost_) {
+            boost(current_time);
+        }
+        catch_up_boost(current_process);
+        if (process(current_process).remaining_time() <= 0) {
+            return true;
+        }
+
+        int level = level_[current_process];
+        return ++used_[current_process] >= quanta_[level] || higher_level_waiting(level);
+    }
+
+    int ticks_until_preemption(ProcessHandle current_process, int current_time) const override {
+        if (process(current_process).remaining_time() <= 0 || current_time >= next_boost_) {
+            return 0;
+        }
+
+        // A boost since this process last checked has already put it back on level 0
+        bool boosted = epoch_[current_process] != boost_epoch_;
+        int level = boosted ? 0 : level_[current_process];
+        int used = boosted ? 0 : used_[current_process];
+        if (higher_level_waiting(level)) {
+            return 0;
+        }
+        // The check at the boost time has to run, since the boost changes the answer
+        return static_cast<int>(std::min<long long>(std::max(0, quanta_[level] - used - 1),
+                                                    next_boost_ - current_time));
+    }
+
+    void skip_ticks(ProcessHandle current_process, int ticks) override {
+        // A process resuming after a context switch has not been checked since any boost
+        catch_up_boost(current_process);
+        used_[current_process] += ticks;
+    }
+
+    std::string name() const override {
+        return "MLFQ (levels=" + std::to_string(levels_) + ", Q=" +
+               std::to_string(quanta_[0]) + ", boost=" + std::to_string(boost_interval_) + ")";
+    }
+
+    int levels() const { return levels_; }
+    int quantum(int level) const { return quanta_[level]; }
+    int level(ProcessHandle handle) const { return level_[handle]; }
+    size_t ready_queue_size() const { return queued_; }
+
+private:
+    static int lowest_set_bit(uint64_t bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+
+    bool higher_level_waiting(int level) const {
+        return (nonempty_ & ((uint64_t{1} << level) - 1)) != 0;
+    }
+
+    void enqueue(ProcessHandle handle) {
+        int level = level_[handle];
+        process(handle).set_state(Process::ProcessState::READY);
+        queues_[level].push_back(handle);
+        nonempty_ |= uint64_t{1} << level;
+        queued_++;
+    }
+
+    // Move every queued process to level 0, keeping the order they would have run in.
+    // Running processes and the level bookkeeping of queued ones catch up lazily.
+    void boost(int current_time) {
+        auto& top = queues_[0];
+        for (int level = 1; level < levels_; level++) {
+            top.insert(top.end(), queues_[level].begin(), queues_[level].end());
+            queues_[level].clear();
+        }
+        nonempty_ = top.empty() ? 0 : 1;
+        boost_epoch_++;
+        next_boost_ += ((current_time - next_boost_) / boost_interval_ + 1) *
+                       static_cast<long long>(boost_interval_);
+    }
+
+    void catch_up_boost(ProcessHandle handle) {
+        if (epoch_[handle] != boost_epoch_) {
+            level_[handle] = 0;
+            used_[handle] = 0;
+            epoch_[handle] = boost_epoch_;
+        }
+    }
+
+    int levels_;
+    int boost_interval_;
+    long long next_boost_;
+    std::vector<int> quanta_;                      // Per level
+    std::vector<std::deque<ProcessHandle>> queues_;  // Per level, FIFO
+    uint64_t nonempty_{0};                         // Bit i set while queues_[i] has work
+    size_t queued_{0};
+    uint64_t boost_epoch_{0};                      // Number of boosts so far
+    std::vector<int> level_;                       // Indexed by process handle
+    std::vector<int> used_;                        // Quantum used at the current level
+    std::vector<uint64_t> epoch_;                  // Boost epoch level_ and used_ refer to
+};
+
+} // namespace cpu_scheduler
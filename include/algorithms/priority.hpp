@@ -1,8 +1,7 @@
 #pragma once
 
+#include "core/ready_heap.hpp"
 #include "core/scheduler.hpp"
-#include <queue>
-#include <vector>
 #include <algorithm>
 
 namespace cpu_scheduler {
@@ -12,63 +11,93 @@ namespace cpu_scheduler {
  * 
  * This scheduler implements the Priority scheduling algorithm, which selects the process
  * with the highest priority to execute next. Lower priority number means higher priority.
- * This implementation is preemptive.
+ * This implementation is preemptive. The ready queue is a binary heap, so insertion and
+ * dispatch are O(log n) and equal priorities are served in arrival order.
+ *
+ * With aging, a waiting process gains one priority level for every aging_interval time
+ * units in the queue, which bounds how long it can starve. Its effective priority at time
+ * t is priority - (t - enqueued) / aging_interval, and every queued process ages at the
+ * same rate, so their order never changes: the heap is keyed on the fixed
+ * priority * aging_interval + enqueued and nothing is ever re-sorted. A process waits from
+ * its arrival time, or from the last preemption check when it is preempted.
  */
 class PriorityScheduler : public Scheduler {
 public:
-    explicit PriorityScheduler(bool preemptive = true)
-        : preemptive_(preemptive) {}
+    explicit PriorityScheduler(bool preemptive = true, int aging_interval = 0)
+        : preemptive_(preemptive), aging_interval_(std::max(aging_interval, 0)) {}
 
-    void add_process(std::shared_ptr<Process> process) override {
-        processes_[process->pid()] = process;
-        process->set_state(Process::ProcessState::READY);
-        ready_queue_.push_back(process);
-        sort_queue();
+    void add_process(ProcessHandle handle) override {
+        enqueue(handle, process(handle).arrival_time());
     }
 
-    std::optional<std::shared_ptr<Process>> get_next_process() override {
+    std::optional<ProcessHandle> get_next_process() override {
         if (ready_queue_.empty()) {
             return std::nullopt;
         }
-        auto next = ready_queue_.front();
-        ready_queue_.erase(ready_queue_.begin());
-        next->set_state(Process::ProcessState::RUNNING);
+        auto next = ready_queue_.pop();
+        process(next).set_state(Process::ProcessState::RUNNING);
         return next;
     }
 
-    void preempt_process(std::shared_ptr<Process> current_process) override {
-        if (current_process && current_process->remaining_time() > 0) {
-            current_process->set_state(Process::ProcessState::READY);
-            ready_queue_.push_back(current_process);
-            sort_queue();
+    void preempt_process(ProcessHandle current_process) override {
+        if (process(current_process).remaining_time() > 0) {
+            enqueue(current_process, last_check_time_);
         }
     }
 
-    bool needs_preemption(std::shared_ptr<Process> current_process, int) override {
-        if (!preemptive_ || ready_queue_.empty() || !current_process) {
+    bool needs_preemption(ProcessHandle current_process, int current_time) override {
+        last_check_time_ = current_time;
+        if (!preemptive_ || ready_queue_.empty()) {
             return false;
         }
-        return ready_queue_.front()->priority() < current_process->priority();
+        return ready_queue_.top_key() < key(current_process, current_time);
+    }
+
+    int ticks_until_preemption(ProcessHandle current_process, int current_time) const override {
+        // The ready queue is frozen between events, so the answer cannot change until then
+        if (!preemptive_ || ready_queue_.empty()) {
+            return std::numeric_limits<int>::max();
+        }
+        long long margin = ready_queue_.top_key() - key(current_process, current_time);
+        if (aging_interval_ == 0 || margin < 0) {
+            return margin < 0 ? 0 : std::numeric_limits<int>::max();
+        }
+        // The running process is compared as if it had just been queued, so its key grows
+        // by one per check until the top of the queue beats it
+        return static_cast<int>(
+            std::min<long long>(margin + 1, std::numeric_limits<int>::max()));
     }
 
     std::string name() const override {
-        return preemptive_ ? "Preemptive Priority" : "Non-preemptive Priority";
+        std::string name = preemptive_ ? "Preemptive Priority" : "Non-preemptive Priority";
+        if (aging_interval_ > 0) {
+            name += " (aging=" + std::to_string(aging_interval_) + ")";
+        }
+        return name;
     }
 
+    int aging_interval() const { return aging_interval_; }
+
     size_t ready_queue_size() const {
         return ready_queue_.size();
     }
 
 private:
-    void sort_queue() {
-        std::sort(ready_queue_.begin(), ready_queue_.end(),
-            [](const auto& a, const auto& b) {
-                return a->priority() < b->priority();
-            });
+    // Effective-priority order for a process queued at the given time
+    long long key(ProcessHandle handle, int enqueued) const {
+        long long priority = process(handle).priority();
+        return aging_interval_ > 0 ? priority * aging_interval_ + enqueued : priority;
+    }
+
+    void enqueue(ProcessHandle handle, int enqueued) {
+        process(handle).set_state(Process::ProcessState::READY);
+        ready_queue_.push(key(handle, enqueued), handle);
     }
 
     bool preemptive_;
-    std::vector<std::shared_ptr<Process>> ready_queue_;
+    int aging_interval_;
+    int last_check_time_{0};
+    ReadyHeap<long long> ready_queue_;  // Keyed on effective priority, FIFO among ties
 };
 
-} // namespace cpu_scheduler 
\ No newline at end of file
+} // namespace cpu_scheduler
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "core/scheduler.hpp"
+#include <algorithm>
 #include <queue>
+#include <vector>
 
 namespace cpu_scheduler {
 
@@ -10,46 +12,60 @@ namespace cpu_scheduler {
  * 
  * This scheduler implements the Round Robin algorithm with a configurable time quantum.
  * Processes are executed in FIFO order, with each process getting a maximum time slice
- * equal to the quantum before being preempted.
+ * equal to the quantum before being preempted. Time slices are tracked per process, so
+ * several CPUs can share one scheduler.
  */
 class RoundRobinScheduler : public Scheduler {
 public:
     explicit RoundRobinScheduler(int quantum) 
-        : quantum_(quantum), current_time_slice_(0) {}
+        : quantum_(quantum) {}
 
-    void add_process(std::shared_ptr<Process> process) override {
-        processes_[process->pid()] = process;
-        process->set_state(Process::ProcessState::READY);
-        ready_queue_.push(process);
+    void add_process(ProcessHandle handle) override {
+        if (handle >= time_slices_.size()) {
+            time_slices_.resize(handle + 1, 0);
+        }
+        process(handle).set_state(Process::ProcessState::READY);
+        ready_queue_.push(handle);
     }
 
-    std::optional<std::shared_ptr<Process>> get_next_process() override {
+    std::optional<ProcessHandle> get_next_process() override {
         if (ready_queue_.empty()) {
             return std::nullopt;
         }
 
         auto next = ready_queue_.front();
         ready_queue_.pop();
-        next->set_state(Process::ProcessState::RUNNING);
-        current_time_slice_ = 0;
+        process(next).set_state(Process::ProcessState::RUNNING);
+        time_slices_[next] = 0;
         return next;
     }
 
-    void preempt_process(std::shared_ptr<Process> current_process) override {
-        if (current_process && current_process->remaining_time() > 0) {
-            current_process->set_state(Process::ProcessState::READY);
+    void preempt_process(ProcessHandle current_process) override {
+        if (process(current_process).remaining_time() > 0) {
+            process(current_process).set_state(Process::ProcessState::READY);
             ready_queue_.push(current_process);
         }
-        current_time_slice_ = 0;
+        time_slices_[current_process] = 0;
     }
 
-    bool needs_preemption(std::shared_ptr<Process> current_process, int current_time) override {
-        if (!current_process || current_process->remaining_time() <= 0) {
+    bool needs_preemption(ProcessHandle current_process, int current_time) override {
+        if (process(current_process).remaining_time() <= 0) {
             return true;
         }
 
-        current_time_slice_++;
-        return current_time_slice_ >= quantum_;
+        return ++time_slices_[current_process] >= quantum_;
+    }
+
+    int ticks_until_preemption(ProcessHandle current_process, int) const override {
+        if (process(current_process).remaining_time() <= 0) {
+            return 0;
+        }
+        // Each check bumps the slice first, so the one that reaches the quantum fires
+        return std::max(0, quantum_ - time_slices_[current_process] - 1);
+    }
+
+    void skip_ticks(ProcessHandle current_process, int ticks) override {
+        time_slices_[current_process] += ticks;
     }
 
     std::string name() const override {
@@ -58,13 +74,13 @@ public:
 
     // Additional RR-specific methods
     int quantum() const { return quantum_; }
-    int current_time_slice() const { return current_time_slice_; }
+    int current_time_slice(ProcessHandle handle) const { return time_slices_[handle]; }
     size_t ready_queue_size() const { return ready_queue_.size(); }
 
 private:
     int quantum_;
-    int current_time_slice_;
-    std::queue<std::shared_ptr<Process>> ready_queue_;
+    std::queue<ProcessHandle> ready_queue_;
+    std::vector<int> time_slices_;  // Checks since dispatch, indexed by process handle
 };
 
 } // namespace cpu_scheduler 
\ No newline at end of file
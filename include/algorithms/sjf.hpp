@@ -1,9 +1,7 @@
 #pragma once
 
+#include "core/ready_heap.hpp"
 #include "core/scheduler.hpp"
-#include <queue>
-#include <vector>
-#include <algorithm>
 
 namespace cpu_scheduler {
 
@@ -11,43 +9,57 @@ namespace cpu_scheduler {
  * @brief Shortest Job First (SJF) scheduling algorithm implementation
  * 
  * This scheduler implements the SJF algorithm, which selects the process with
- * the shortest burst time to execute next. This implementation is non-preemptive.
+ * the shortest burst time to execute next. By default it is non-preemptive; in
+ * preemptive mode it is Shortest Remaining Time First (SRTF), where a ready process
+ * with less remaining time than the running one takes over the CPU.
+ * The ready queue is a binary heap, so both insertion and dispatch are O(log n) and the
+ * preemption check is an O(1) look at its top.
  */
 class SJFScheduler : public Scheduler {
 public:
-    SJFScheduler() = default;
+    explicit SJFScheduler(bool preemptive = false)
+        : preemptive_(preemptive) {}
 
-    void add_process(std::shared_ptr<Process> process) override {
-        processes_[process->pid()] = process;
-        process->set_state(Process::ProcessState::READY);
-        ready_queue_.push_back(process);
-        sort_queue();
+    void add_process(ProcessHandle handle) override {
+        process(handle).set_state(Process::ProcessState::READY);
+        ready_queue_.push(process(handle).remaining_time(), handle);
     }
 
-    std::optional<std::shared_ptr<Process>> get_next_process() override {
+    std::optional<ProcessHandle> get_next_process() override {
         if (ready_queue_.empty()) {
             return std::nullopt;
         }
-        auto next = ready_queue_.front();
-        ready_queue_.erase(ready_queue_.begin());
-        next->set_state(Process::ProcessState::RUNNING);
+        auto next = ready_queue_.pop();
+        process(next).set_state(Process::ProcessState::RUNNING);
         return next;
     }
 
-    void preempt_process(std::shared_ptr<Process> current_process) override {
-        if (current_process && current_process->remaining_time() > 0) {
-            current_process->set_state(Process::ProcessState::READY);
-            ready_queue_.push_back(current_process);
-            sort_queue();
+    void preempt_process(ProcessHandle current_process) override {
+        if (process(current_process).remaining_time() > 0) {
+            process(current_process).set_state(Process::ProcessState::READY);
+            ready_queue_.push(process(current_process).remaining_time(), current_process);
         }
     }
 
-    bool needs_preemption(std::shared_ptr<Process>, int) override {
-        return false;  // Non-preemptive SJF
+    bool needs_preemption(ProcessHandle current_process, int) override {
+        if (!preemptive_ || ready_queue_.empty()) {
+            return false;
+        }
+        return ready_queue_.top_key() < process(current_process).remaining_time();
+    }
+
+    int ticks_until_preemption(ProcessHandle current_process, int) const override {
+        // Queued keys are fixed and the running process only gets shorter, so if it is not
+        // preempted now it will not be until the ready queue changes
+        if (!preemptive_ || ready_queue_.empty()) {
+            return std::numeric_limits<int>::max();
+        }
+        return ready_queue_.top_key() < process(current_process).remaining_time()
+            ? 0 : std::numeric_limits<int>::max();
     }
 
     std::string name() const override {
-        return "Shortest Job First";
+        return preemptive_ ? "Shortest Remaining Time First" : "Shortest Job First";
     }
 
     size_t ready_queue_size() const {
@@ -55,14 +67,8 @@ public:
     }
 
 private:
-    void sort_queue() {
-        std::sort(ready_queue_.begin(), ready_queue_.end(),
-            [](const auto& a, const auto& b) {
-                return a->remaining_time() < b->remaining_time();
-            });
-    }
-
-    std::vector<std::shared_ptr<Process>> ready_queue_;
+    bool preemptive_;
+    ReadyHeap<int> ready_queue_;  // Keyed on remaining_time, FIFO among ties
 };
 
 } // namespace cpu_scheduler 
\ No newline at end of file
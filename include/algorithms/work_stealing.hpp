@@ -0,0 +1,126 @@
+#pragma once
+
+#include "core/scheduler.hpp"
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Work-stealing scheduler with one run queue per CPU
+ *
+ * Each CPU runs its own queue round robin with a fixed time quantum, and a preempted
+ * process goes back on the queue of the CPU it ran on. New arrivals are spread over the
+ * CPUs in turn. A CPU whose queue is empty steals half of the longest queue, taking from
+ * the opposite end to the one its owner dispatches from, like the Go runtime or Linux
+ * load balancing. The simulator drives all CPUs from one thread, so the queues are
+ * plain deques with no synchronization.
+ */
+class WorkStealingScheduler : public Scheduler {
+public:
+    explicit WorkStealingScheduler(int quantum)
+        : quantum_(quantum), run_queues_(1) {}
+
+    void set_cpu_count(int cpus) override {
+        run_queues_.assign(std::max(cpus, 1), {});
+        next_cpu_ = 0;
+        queued_ = 0;
+        steals_ = 0;
+    }
+
+    void add_process(ProcessHandle handle) override {
+        if (handle >= time_slices_.size()) {
+            time_slices_.resize(handle + 1, 0);
+        }
+        process(handle).set_state(Process::ProcessState::READY);
+        run_queues_[next_cpu_].push_back(handle);
+        next_cpu_ = (next_cpu_ + 1) % run_queues_.size();
+        queued_++;
+    }
+
+    std::optional<ProcessHandle> get_next_process() override {
+        return get_next_process_on(0);
+    }
+
+    std::optional<ProcessHandle> get_next_process_on(int cpu) override {
+        if (queued_ == 0) {
+            return std::nullopt;
+        }
+
+        auto& local = run_queues_[cpu];
+        if (local.empty()) {
+            steal_into(local);
+        }
+
+        auto next = local.front();
+        local.pop_front();
+        queued_--;
+        process(next).set_state(Process::ProcessState::RUNNING);
+        time_slices_[next] = 0;
+        return next;
+    }
+
+    void preempt_process(ProcessHandle current_process) override {
+        preempt_process_on(current_process, 0);
+    }
+
+    void preempt_process_on(ProcessHandle current_process, int cpu) override {
+        if (process(current_process).remaining_time() > 0) {
+            process(current_process).set_state(Process::ProcessState::READY);
+            run_queues_[cpu].push_back(current_process);
+            queued_++;
+        }
+        time_slices_[current_process] = 0;
+    }
+
+    bool needs_preemption(ProcessHandle current_process, int) override {
+        if (process(current_process).remaining_time() <= 0) {
+            return true;
+        }
+        return ++time_slices_[current_process] >= quantum_;
+    }
+
+    int ticks_until_preemption(ProcessHandle current_process, int) const override {
+        if (process(current_process).remaining_time() <= 0) {
+            return 0;
+        }
+        return std::max(0, quantum_ - time_slices_[current_process] - 1);
+    }
+
+    void skip_ticks(ProcessHandle current_process, int ticks) override {
+        time_slices_[current_process] += ticks;
+    }
+
+    int steals() const override { return steals_; }
+
+    std::string name() const override {
+        return "Work Stealing (Q=" + std::to_string(quantum_) + ")";
+    }
+
+    int quantum() const { return quantum_; }
+    size_t ready_queue_size() const { return queued_; }
+    size_t run_queue_size(int cpu) const { return run_queues_[cpu].size(); }
+
+private:
+    // Only called with work queued somewhere, so the longest queue is never empty
+    void steal_into(std::deque<ProcessHandle>& local) {
+        auto victim = std::max_element(run_queues_.begin(), run_queues_.end(),
+            [](const auto& a, const auto& b) { return a.size() < b.size(); });
+
+        // Take the newest half (at least one) so the victim keeps its oldest work
+        size_t count = (victim->size() + 1) / 2;
+        local.insert(local.end(), victim->end() - count, victim->end());
+        victim->erase(victim->end() - count, victim->end());
+        steals_++;
+    }
+
+    int quantum_;
+    std::vector<std::deque<ProcessHandle>> run_queues_;  // One per CPU
+    std::vector<int> time_slices_;  // Checks since dispatch, indexed by process handle
+    size_t next_cpu_{0};            // Queue that receives the next arrival
+    size_t queued_{0};              // Total over all run queues
+    int steals_{0};
+};
+
+} // namespace cpu_scheduler
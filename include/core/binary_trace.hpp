@@ -0,0 +1,102 @@
+#pragma once
+
+#include "core/process_source.hpp"
+#include "core/workload.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Fixed header at the start of a binary workload trace
+ *
+ * The header is followed by record_count packed WorkloadEntry records (arrival, burst,
+ * priority as 32-bit little-endian integers) sorted by arrival time. All header fields
+ * are little-endian too; a file with its version byte-swapped is rejected as coming from a
+ * host of the other byte order.
+ */
+struct BinaryTraceHeader {
+    char magic[8];          // "CPUTRACE"
+    uint32_t version;
+    uint32_t record_size;   // sizeof(WorkloadEntry), checked on load
+    uint64_t record_count;
+};
+
+static_assert(sizeof(BinaryTraceHeader) == 24, "trace header must stay packed");
+static_assert(sizeof(WorkloadEntry) == 12, "trace records are three 32-bit integers");
+// Headers and records are written and mapped in native byte order
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "binary traces are little-endian and read in place, so need a little-endian host");
+
+constexpr char kBinaryTraceMagic[8] = {'C', 'P', 'U', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t kBinaryTraceVersion = 1;
+
+/**
+ * @brief True if version is expected with its bytes reversed, i.e. the file was written
+ *        with the other byte order
+ */
+constexpr bool is_byte_swapped(uint32_t version, uint32_t expected) {
+    return version != expected &&
+           version == ((expected >> 24) | ((expected >> 8) & 0xff00u) |
+                       ((expected << 8) & 0xff0000u) | (expected << 24));
+}
+
+/**
+ * @brief Write a workload as a binary trace, sorting it by arrival first
+ * @throws std::runtime_error if the file cannot be written
+ */
+void write_binary_trace(const std::string& filename, Workload workload);
+
+/**
+ * @brief True if the file starts with the binary trace magic
+ */
+bool is_binary_trace(const std::string& filename);
+
+/**
+ * @brief Read-only memory mapping of a binary trace
+ *
+ * Records are used in place; pages are only faulted in as they are read.
+ */
+class MappedTrace {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be mapped or has a bad header
+     */
+    explicit MappedTrace(const std::string& filename);
+    ~MappedTrace();
+
+    MappedTrace(const MappedTrace&) = delete;
+    MappedTrace& operator=(const MappedTrace&) = delete;
+
+    const WorkloadEntry* records() const { return records_; }
+    size_t size() const { return count_; }
+
+private:
+    void* data_{nullptr};
+    size_t length_{0};
+    const WorkloadEntry* records_{nullptr};
+    size_t count_{0};
+};
+
+/**
+ * @brief Streams the records of a mapped trace into the simulator
+ */
+class BinaryTraceSource : public ProcessSource {
+public:
+    explicit BinaryTraceSource(const std::string& filename) : trace_(filename) {}
+
+    bool next(WorkloadEntry& entry) override {
+        if (next_ == trace_.size()) {
+            return false;
+        }
+        entry = trace_.records()[next_++];
+        return true;
+    }
+
+private:
+    MappedTrace trace_;
+    size_t next_{0};
+};
+
+} // namespace cpu_scheduler
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "core/event_trace.hpp"
+#include <ostream>
+#include <vector>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Which timeline rows a Chrome trace has
+ */
+enum class ChromeTraceTracks {
+    CPU,      // One row per CPU showing the process it ran
+    PROCESS   // One row per process showing the CPU it ran on
+};
+
+/**
+ * @brief Streams simulation events as Chrome trace-event JSON
+ *
+ * Each stretch of execution from a START to the PREEMPT or COMPLETE on the same CPU
+ * becomes one complete ("X") event, and arrivals become instant events. Events are
+ * written to the stream as each batch arrives; the only state kept is the open slice of
+ * each CPU and which rows have been named, so the output can be far larger than memory.
+ * The result loads in chrome://tracing and ui.perfetto.dev.
+ */
+class ChromeTraceWriter : public TraceSink {
+public:
+    /**
+     * @param out Stream to write to; must outlive the writer
+     * @param tracks Whether rows are CPUs or processes
+     * @param time_scale Microseconds per simulated time unit
+     */
+    explicit ChromeTraceWriter(std::ostream& out, ChromeTraceTracks tracks = ChromeTraceTracks::CPU,
+                               int time_scale = 1000);
+    ~ChromeTraceWriter() override;
+
+    ChromeTraceWriter(const ChromeTraceWriter&) = delete;
+    ChromeTraceWriter& operator=(const ChromeTraceWriter&) = delete;
+
+    void write(const TraceEvent* events, size_t count) override;
+
+    /**
+     * @brief Close the JSON document; called by the destructor if not before
+     */
+    void finish();
+
+private:
+    struct Slice {
+        bool open{false};
+        int pid{0};
+        int start{0};
+    };
+
+    void write_event(const TraceEvent& event);
+    void close_slice(int cpu, int end, const char* reason);
+    void name_track(int tid);
+    void begin_record();
+    long long timestamp(int time) const { return static_cast<long long>(time) * time_scale_; }
+
+    std::ostream& out_;
+    ChromeTraceTracks tracks_;
+    int time_scale_;
+    bool first_{true};
+    bool finished_{false};
+    std::vector<Slice> slices_;   // Indexed by CPU
+    std::vector<bool> named_;     // Indexed by track id + 1, so the arrivals row fits
+};
+
+} // namespace cpu_scheduler
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "core/binary_trace.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief What happened to a process at a point in a simulation
+ */
+enum class TraceEventKind : uint8_t {
+    ARRIVE,    // Admitted to the scheduler; not on any CPU
+    START,     // Began executing on a CPU, after any context switch overhead
+    PREEMPT,   // Taken off its CPU with work left
+    COMPLETE   // Finished; the time is the end of its last unit
+};
+
+/**
+ * @brief One fixed-size record of a simulation event trace
+ */
+struct TraceEvent {
+    int32_t time;
+    int32_t pid;
+    int16_t cpu;          // -1 for ARRIVE
+    TraceEventKind kind;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(TraceEvent) == 12, "trace events must stay packed");
+
+constexpr char kEventTraceMagic[8] = {'C', 'P', 'U', 'E', 'V', 'E', 'N', 'T'};
+constexpr uint32_t kEventTraceVersion = 1;
+
+/** @brief Most CPUs a traced run can have, so that every CPU index fits TraceEvent::cpu */
+constexpr int kMaxEventTraceCpus = std::numeric_limits<int16_t>::max() + 1;
+
+/**
+ * @brief Destination for batches of recorded events
+ */
+class TraceSink {
+public:
+    virtual ~TraceSink() = default;
+
+    /**
+     * @brief Take a batch of events, in the order they happened
+     */
+    virtual void write(const TraceEvent* events, size_t count) = 0;
+};
+
+/**
+ * @brief Buffers simulation events and hands them to a sink a chunk at a time
+ *
+ * The buffer is allocated once up front and each event is a plain 12-byte store, so
+ * tracing a run of millions of events costs one virtual call per chunk and no other
+ * allocation. The simulator only holds a pointer to a recorder, so with none attached
+ * the cost is a null check per event.
+ */
+class EventRecorder {
+public:
+    static constexpr size_t kDefaultChunkEvents = size_t{1} << 16;
+
+    explicit EventRecorder(TraceSink& sink, size_t chunk_events = kDefaultChunkEvents)
+        : sink_(sink), buffer_(chunk_events > 0 ? chunk_events : 1) {}
+
+    void record(int time, int pid, int cpu, TraceEventKind kind) {
+        if (fill_ == buffer_.size()) {
+            flush();
+        }
+        buffer_[fill_++] = TraceEvent{time, pid, static_cast<int16_t>(cpu), kind, 0};
+        recorded_++;
+    }
+
+    /**
+     * @brief Pass every buffered event to the sink
+     */
+    void flush() {
+        if (fill_ > 0) {
+            sink_.write(buffer_.data(), fill_);
+            fill_ = 0;
+        }
+    }
+
+    uint64_t recorded() const { return recorded_; }
+
+private:
+    TraceSink& sink_;
+    std::vector<TraceEvent> buffer_;
+    size_t fill_{0};
+    uint64_t recorded_{0};
+};
+
+/**
+ * @brief Keeps every event in memory
+ */
+class MemoryTraceSink : public TraceSink {
+public:
+    void write(const TraceEvent* events, size_t count) override {
+        events_.insert(events_.end(), events, events + count);
+    }
+
+    const std::vector<TraceEvent>& events() const { return events_; }
+
+private:
+    std::vector<TraceEvent> events_;
+};
+
+/**
+ * @brief Passes every batch on to two other sinks
+ */
+class TeeTraceSink : public TraceSink {
+public:
+    TeeTraceSink(TraceSink& first, TraceSink& second) : first_(first), second_(second) {}
+
+    void write(const TraceEvent* events, size_t count) override {
+        first_.write(events, count);
+        second_.write(events, count);
+    }
+
+private:
+    TraceSink& first_;
+    TraceSink& second_;
+};
+
+/**
+ * @brief Writes events to a binary file as they are flushed
+ *
+ * The file has a BinaryTraceHeader with the "CPUEVENT" magic followed by packed
+ * little-endian TraceEvent records. The record count in the header is brought up to date after every
+ * batch, so the file is complete whenever the recorder has been flushed.
+ */
+class BinaryEventTraceWriter : public TraceSink {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be created
+     */
+    explicit BinaryEventTraceWriter(const std::string& filename);
+
+    /**
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const TraceEvent* events, size_t count) override;
+
+private:
+    std::string filename_;
+    std::ofstream out_;
+    uint64_t count_{0};
+};
+
+/**
+ * @brief Read back a file written by BinaryEventTraceWriter
+ * @throws std::runtime_error if the file cannot be read or has a bad header
+ */
+std::vector<TraceEvent> read_event_trace(const std::string& filename);
+
+} // namespace cpu_scheduler
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "core/process_source.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Streams the CPU bursts recorded in a Linux scheduler trace as processes
+ *
+ * Reads the text output of ftrace (`trace` or `trace_pipe` with the sched_switch and
+ * sched_wakeup events enabled) or of `perf sched script`. Every stretch of a task's life
+ * from waking up to going to sleep becomes one process: it arrives at the wakeup, its
+ * burst is the time it spent on a CPU until it switched out in a sleeping state, and its
+ * priority is the kernel prio less 120, i.e. the nice value for normal tasks and below
+ * -20 for real-time ones. Tasks already running when the trace starts arrive at their
+ * first switch-in, and tasks still runnable when it ends keep the time they have run.
+ * The idle task (pid 0) is skipped.
+ *
+ * The file is memory-mapped and lines are scanned in place without copying. Because a
+ * burst is only known once its task sleeps, finished bursts wait in a heap until no task
+ * still awake could have arrived before them, so the output is in arrival order. A task
+ * that never sleeps would hold back every later burst, so a burst still open after the
+ * split horizon is cut there: the part so far becomes its own process and the rest
+ * arrives at the cut. Memory is then proportional to the tasks awake at once plus the
+ * bursts that finish within one horizon. With splitting disabled it grows with every
+ * burst behind the oldest unfinished one.
+ */
+class FtraceSource : public ProcessSource {
+public:
+    static constexpr long long kDefaultSplitAfterUs = 1000000;
+
+    /**
+     * @param filename Text trace to read
+     * @param time_unit_us Microseconds per simulated time unit; bursts shorter than one
+     *                     unit still take one
+     * @param split_after_us Longest a burst may stay open before it is cut, 0 for never
+     * @throws std::runtime_error if the file cannot be mapped
+     */
+    explicit FtraceSource(const std::string& filename, int time_unit_us = 1,
+                          long long split_after_us = kDefaultSplitAfterUs);
+    ~FtraceSource() override;
+
+    FtraceSource(const FtraceSource&) = delete;
+    FtraceSource& operator=(const FtraceSource&) = delete;
+
+    /**
+     * @throws std::runtime_error if a time does not fit the simulator's clock
+     */
+    bool next(WorkloadEntry& entry) override;
+
+    /**
+     * @brief Number of sched_switch and sched_wakeup lines read so far
+     */
+    uint64_t events_parsed() const { return events_; }
+
+    /**
+     * @brief Number of finished bursts held back until earlier arrivals are known
+     */
+    size_t buffered() const { return finished_.size(); }
+
+private:
+    struct Task {
+        bool awake{false};
+        long long arrival{0};         // Nanoseconds since the first event
+        long long ran{0};
+        long long on_cpu_since{-1};   // -1 while off CPU
+        int priority{0};
+        std::set<std::pair<long long, int>>::iterator pending;  // Entry in awake_arrivals_
+    };
+
+    struct Burst {
+        long long arrival;
+        uint64_t seq;   // Keeps bursts that arrive together in the order they ended
+        long long ran;
+        int priority;
+
+        bool operator>(const Burst& other) const {
+            return arrival != other.arrival ? arrival > other.arrival : seq > other.seq;
+        }
+    };
+
+    bool parse_line(std::string_view line);
+    void wake(int pid, int prio, long long time);
+    void switch_out(int pid, std::string_view state, long long time);
+    void switch_in(int pid, int prio, long long time);
+    void split_long_bursts(long long time);
+    void finish_burst(int pid, Task& task);
+    void drain_at_end();
+    WorkloadEntry to_entry(const Burst& burst) const;
+
+    void* data_{nullptr};
+    size_t length_{0};
+    std::string_view text_;
+    size_t offset_{0};
+    long long time_unit_ns_;
+    long long split_after_ns_;
+    long long first_time_{-1};
+    long long last_time_{0};
+    uint64_t events_{0};
+    uint64_t next_seq_{0};
+    bool at_end_{false};
+    std::unordered_map<int, Task> tasks_;   // Tasks awake or on a CPU
+    std::set<std::pair<long long, int>> awake_arrivals_;  // (arrival, pid) of open bursts
+    std::priority_queue<Burst, std::vector<Burst>, std::greater<Burst>> finished_;
+};
+
+/**
+ * @brief True if the file starts like an ftrace or perf sched text trace
+ */
+bool is_ftrace(const std::string& filename);
+
+} // namespace cpu_scheduler
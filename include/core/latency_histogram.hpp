@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Fixed-size log-linear histogram of non-negative times, in the style of HdrHistogram
+ *
+ * Values below 256 get a bucket each. Above that, every power-of-two range is split into
+ * 128 equal buckets, so any recorded value is known to within 1/128 of itself whatever
+ * its magnitude. The whole int range takes a few thousand counters, so memory does not
+ * grow with the number of processes recorded. Recording is O(1).
+ */
+class LatencyHistogram {
+public:
+    /**
+     * @brief Count one value; negative values are counted as 0
+     */
+    void record(int value) {
+        uint32_t v = static_cast<uint32_t>(std::max(value, 0));
+        counts_[bucket_of(v)]++;
+        total_++;
+        max_ = std::max(max_, static_cast<int>(v));
+    }
+
+    /**
+     * @brief Add every value recorded by another histogram
+     */
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < kBuckets; i++) {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    uint64_t count() const { return total_; }
+    int max() const { return max_; }
+
+    /**
+     * @brief Smallest value that at least the given percentage of values do not exceed
+     *
+     * Exact below 256, otherwise the top of the bucket holding it (never above max()).
+     * @param percentile Between 0 and 100
+     * @return The value, or 0 if nothing was recorded
+     */
+    int percentile(double percentile) const {
+        if (total_ == 0) {
+            return 0;
+        }
+        double fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+        uint64_t rank = std::max<uint64_t>(
+            1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total_))));
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; i++) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                return static_cast<int>(std::min<uint64_t>(highest_in_bucket(i), max_));
+            }
+        }
+        return max_;
+    }
+
+private:
+    static constexpr int kSubBucketBits = 8;
+    static constexpr uint32_t kSubBuckets = 1u << kSubBucketBits;  // Exact range
+    static constexpr uint32_t kHalf = kSubBuckets / 2;              // Buckets per doubling
+    static constexpr int kMagnitudes = 31 - kSubBucketBits;        // Doublings above it
+    static constexpr size_t kBuckets = kSubBuckets + kMagnitudes * kHalf;
+
+    // Values in [2^(m+7), 2^(m+8)) are shifted right by m, landing in [128, 256)
+    static size_t bucket_of(uint32_t v) {
+        if (v < kSubBuckets) {
+            return v;
+        }
+        int magnitude = highest_bit(v) - kSubBucketBits + 1;
+        return static_cast<size_t>(magnitude) * kHalf + (v >> magnitude);
+    }
+
+    static uint64_t highest_in_bucket(size_t bucket) {
+        if (bucket < kSubBuckets) {
+            return bucket;
+        }
+        size_t magnitude = (bucket - kHalf) / kHalf;
+        uint64_t sub = bucket - magnitude * kHalf;
+        return ((sub + 1) << magnitude) - 1;
+    }
+
+    static int highest_bit(uint32_t v) {
+        int bit = 0;
+        while (v >>= 1) {
+            bit++;
+        }
+        return bit;
+    }
+
+    std::array<uint64_t, kBuckets> counts_{};
+    uint64_t total_{0};
+    int max_{0};
+};
+
+} // namespace cpu_scheduler
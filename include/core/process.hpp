@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Process Control Block (PCB) representing a process in the system
+ */
+class Process {
+public:
+    Process(int pid, int arrival_time, int burst_time, int priority = 0)
+        : pid_(pid), arrival_time_(arrival_time), burst_time_(burst_time),
+          remaining_time_(burst_time), priority_(priority), state_(ProcessState::NEW) {}
+
+    enum class ProcessState : uint8_t {
+        NEW,
+        READY,
+        RUNNING,
+        WAITING,
+        TERMINATED,
+        ZOMBIE
+    };
+
+    // Getters
+    int pid() const { return pid_; }
+    int arrival_time() const { return arrival_time_; }
+    int burst_time() const { return burst_time_; }
+    int remaining_time() const { return remaining_time_; }
+    int priority() const { return priority_; }
+    ProcessState state() const { return state_; }
+    
+    // Setters
+    void set_state(ProcessState state) { state_ = state; }
+    void set_remaining_time(int time) { remaining_time_ = time; }
+    void decrement_remaining_time() { if (remaining_time_ > 0) remaining_time_--; }
+
+private:
+    int pid_;
+    int arrival_time_;
+    int burst_time_;
+    int remaining_time_;
+    int priority_;
+    ProcessState state_;
+};
+
+/**
+ * @brief Compact reference to a process: its slot in the owning ProcessTable
+ */
+using ProcessHandle = uint32_t;
+
+class ProcessTable;
+
+/**
+ * @brief View of one row of a ProcessTable with the same accessors as Process
+ *
+ * Cheap to copy; schedulers get one from Scheduler::process() instead of a pointer.
+ */
+class ProcessRef {
+public:
+    ProcessRef(ProcessTable& table, ProcessHandle handle) : table_(&table), handle_(handle) {}
+
+    // Getters
+    inline int pid() const;
+    inline int arrival_time() const;
+    inline int burst_time() const;
+    inline int remaining_time() const;
+    inline int priority() const;
+    inline Process::ProcessState state() const;
+    inline int completion_time() const;
+    inline int first_run_time() const;
+    inline int last_cpu() const;
+
+    // Setters
+    inline void set_state(Process::ProcessState state);
+    inline void set_remaining_time(int time);
+    inline void decrement_remaining_time();
+    inline void set_completion_time(int time);
+    inline void set_first_run_time(int time);
+    inline void set_last_cpu(int cpu);
+
+private:
+    ProcessTable* table_;
+    ProcessHandle handle_;
+};
+
+/**
+ * @brief Column-oriented table of the processes in a simulation
+ *
+ * Owned by the Simulator and shared with its scheduler, which refers to processes by
+ * handle. Each attribute lives in its own contiguous column, so whole-population passes
+ * touch only the columns they need and vectorize. A finished process's row can be
+ * released and is then reused by a later add(), so a long stream of processes needs only
+ * as many rows as are alive at once. Handles stay valid until released or until the table
+ * is reordered with sort_by_arrival().
+ */
+class ProcessTable {
+public:
+    ProcessHandle add(int pid, int arrival_time, int burst_time, int priority = 0) {
+        if (!free_.empty()) {
+            ProcessHandle handle = free_.back();
+            free_.pop_back();
+            pid_[handle] = pid;
+            arrival_time_[handle] = arrival_time;
+            burst_time_[handle] = burst_time;
+            remaining_time_[handle] = burst_time;
+            priority_[handle] = priority;
+            state_[handle] = Process::ProcessState::NEW;
+            completion_time_[handle] = -1;
+            first_run_time_[handle] = -1;
+            last_cpu_[handle] = -1;
+            return handle;
+        }
+        pid_.push_back(pid);
+        arrival_time_.push_back(arrival_time);
+        burst_time_.push_back(burst_time);
+        remaining_time_.push_back(burst_time);
+        priority_.push_back(priority);
+        state_.push_back(Process::ProcessState::NEW);
+        completion_time_.push_back(-1);
+        first_run_time_.push_back(-1);
+        last_cpu_.push_back(-1);
+        return static_cast<ProcessHandle>(pid_.size() - 1);
+    }
+
+    /**
+     * @brief Hand a row back for the next add() to reuse
+     */
+    void release(ProcessHandle handle) { free_.push_back(handle); }
+
+    ProcessRef operator[](ProcessHandle handle) { return ProcessRef(*this, handle); }
+    const ProcessRef operator[](ProcessHandle handle) const {
+        return ProcessRef(const_cast<ProcessTable&>(*this), handle);
+    }
+
+    size_t size() const { return pid_.size(); }  // Rows, including released ones
+    bool empty() const { return pid_.empty(); }
+
+    void reserve(size_t count) {
+        for_each_column([count](auto& column) { column.reserve(count); });
+    }
+
+    // Read-only columns for whole-population passes
+    const std::vector<int>& arrival_times() const { return arrival_time_; }
+    const std::vector<int>& burst_times() const { return burst_time_; }
+    const std::vector<int>& remaining_times() const { return remaining_time_; }
+    const std::vector<int>& completion_times() const { return completion_time_; }
+    const std::vector<int>& first_run_times() const { return first_run_time_; }
+    const std::vector<Process::ProcessState>& states() const { return state_; }
+
+    /**
+     * @brief Reorder the table by arrival time, keeping insertion order among ties
+     */
+    void sort_by_arrival() {
+        if (std::is_sorted(arrival_time_.begin(), arrival_time_.end())) {
+            return;
+        }
+        // Released rows move too, so stop handing them out
+        free_.clear();
+        std::vector<ProcessHandle> order(size());
+        for (ProcessHandle h = 0; h < order.size(); h++) {
+            order[h] = h;
+        }
+        std::stable_sort(order.begin(), order.end(), [this](ProcessHandle a, ProcessHandle b) {
+            return arrival_time_[a] < arrival_time_[b];
+        });
+        for_each_column([&order](auto& column) {
+            std::remove_reference_t<decltype(column)> sorted;
+            sorted.reserve(column.size());
+            for (ProcessHandle h : order) {
+                sorted.push_back(column[h]);
+            }
+            column.swap(sorted);
+        });
+    }
+
+private:
+    friend class ProcessRef;
+
+    template <typename Fn>
+    void for_each_column(Fn fn) {
+        fn(pid_);
+        fn(arrival_time_);
+        fn(burst_time_);
+        fn(remaining_time_);
+        fn(priority_);
+        fn(state_);
+        fn(completion_time_);
+        fn(first_run_time_);
+        fn(last_cpu_);
+    }
+
+    std::vector<int> pid_;
+    std::vector<int> arrival_time_;
+    std::vector<int> burst_time_;
+    std::vector<int> remaining_time_;
+    std::vector<int> priority_;
+    std::vector<Process::ProcessState> state_;
+    std::vector<int> completion_time_;  // End of the last executed unit, -1 until done
+    std::vector<int> first_run_time_;   // Start of the first executed unit, -1 until run
+    std::vector<int> last_cpu_;         // CPU it was last dispatched on, -1 until run
+    std::vector<ProcessHandle> free_;   // Released rows, reused last in first out
+};
+
+int ProcessRef::pid() const { return table_->pid_[handle_]; }
+int ProcessRef::arrival_time() const { return table_->arrival_time_[handle_]; }
+int ProcessRef::burst_time() const { return table_->burst_time_[handle_]; }
+int ProcessRef::remaining_time() const { return table_->remaining_time_[handle_]; }
+int ProcessRef::priority() const { return table_->priority_[handle_]; }
+Process::ProcessState ProcessRef::state() const { return table_->state_[handle_]; }
+int ProcessRef::completion_time() const { return table_->completion_time_[handle_]; }
+int ProcessRef::first_run_time() const { return table_->first_run_time_[handle_]; }
+int ProcessRef::last_cpu() const { return table_->last_cpu_[handle_]; }
+
+void ProcessRef::set_state(Process::ProcessState state) { table_->state_[handle_] = state; }
+void ProcessRef::set_remaining_time(int time) { table_->remaining_time_[handle_] = time; }
+void ProcessRef::decrement_remaining_time() {
+    int& remaining = table_->remaining_time_[handle_];
+    if (remaining > 0) remaining--;
+}
+void ProcessRef::set_completion_time(int time) { table_->completion_time_[handle_] = time; }
+void ProcessRef::set_first_run_time(int time) { table_->first_run_time_[handle_] = time; }
+void ProcessRef::set_last_cpu(int cpu) { table_->last_cpu_[handle_] = cpu; }
+
+} // namespace cpu_scheduler
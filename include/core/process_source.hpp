@@ -0,0 +1,25 @@
+#pragma once
+
+#include "core/workload.hpp"
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Pull-based stream of processes, delivered in arrival order
+ *
+ * Lets the simulator admit processes as the clock reaches them instead of holding the
+ * whole workload up front.
+ */
+class ProcessSource {
+public:
+    virtual ~ProcessSource() = default;
+
+    /**
+     * @brief Read the next process
+     * @param entry Filled in with the next process on success
+     * @return False once the source is exhausted
+     */
+    virtual bool next(WorkloadEntry& entry) = 0;
+};
+
+} // namespace cpu_scheduler
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "core/process.hpp"
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Binary min-heap ready queue ordered by a scheduling key
+ *
+ * Entries with equal keys leave in the order they were pushed, so schedulers built on
+ * top of it stay deterministic. Push and pop are O(log n), peeking is O(1).
+ */
+template <typename Key>
+class ReadyHeap {
+public:
+    void push(Key key, ProcessHandle process) {
+        heap_.push(Entry{key, next_seq_++, process});
+    }
+
+    ProcessHandle pop() {
+        ProcessHandle process = heap_.top().process;
+        heap_.pop();
+        return process;
+    }
+
+    ProcessHandle top() const { return heap_.top().process; }
+    const Key& top_key() const { return heap_.top().key; }
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+
+private:
+    struct Entry {
+        Key key;
+        uint64_t seq;  // Insertion order, breaks ties FIFO
+        ProcessHandle process;
+    };
+
+    struct Later {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.key != b.key ? b.key < a.key : a.seq > b.seq;
+        }
+    };
+
+    std::priority_queue<Entry, std::vector<Entry>, Later> heap_;
+    uint64_t next_seq_{0};
+};
+
+} // namespace cpu_scheduler
@@ -1,79 +1,87 @@
 #pragma once
 
+#include "core/process.hpp"
+#include <limits>
 #include <memory>
-#include <queue>
-#include <vector>
-#include <chrono>
 #include <optional>
 #include <string>
-#include <unordered_map>
 
 namespace cpu_scheduler {
 
-/**
- * @brief Process Control Block (PCB) representing a process in the system
- */
-class Process {
-public:
-    Process(int pid, int arrival_time, int burst_time, int priority = 0)
-        : pid_(pid), arrival_time_(arrival_time), burst_time_(burst_time),
-          remaining_time_(burst_time), priority_(priority), state_(ProcessState::NEW) {}
-
-    enum class ProcessState {
-        NEW,
-        READY,
-        RUNNING,
-        WAITING,
-        TERMINATED,
-        ZOMBIE
-    };
-
-    // Getters
-    int pid() const { return pid_; }
-    int arrival_time() const { return arrival_time_; }
-    int burst_time() const { return burst_time_; }
-    int remaining_time() const { return remaining_time_; }
-    int priority() const { return priority_; }
-    ProcessState state() const { return state_; }
-    
-    // Setters
-    void set_state(ProcessState state) { state_ = state; }
-    void set_remaining_time(int time) { remaining_time_ = time; }
-    void decrement_remaining_time() { if (remaining_time_ > 0) remaining_time_--; }
-
-private:
-    int pid_;
-    int arrival_time_;
-    int burst_time_;
-    int remaining_time_;
-    int priority_;
-    ProcessState state_;
-};
-
 /**
  * @brief Abstract base class for all scheduling algorithms
+ *
+ * On a multi-CPU simulator several processes run at once, each on its own CPU, and all of
+ * them share this scheduler's ready queue. Any state kept about "the" running process
+ * must therefore be kept per process.
  */
 class Scheduler {
 public:
     virtual ~Scheduler() = default;
 
+    /**
+     * @brief Give the scheduler access to the table its process handles refer to
+     * @param table Process table owned by the simulator
+     */
+    void attach(ProcessTable& table) { table_ = &table; }
+
     /**
      * @brief Add a new process to be scheduled
-     * @param process Shared pointer to the process
+     *
+     * The handle of a completed process may be given out again for a later arrival, so
+     * any state kept per handle must be reset here.
+     * @param process Handle of the process
      */
-    virtual void add_process(std::shared_ptr<Process> process) = 0;
+    virtual void add_process(ProcessHandle process) = 0;
 
     /**
      * @brief Get the next process to be scheduled
      * @return Optional containing the next process, or empty if none available
      */
-    virtual std::optional<std::shared_ptr<Process>> get_next_process() = 0;
+    virtual std::optional<ProcessHandle> get_next_process() = 0;
 
     /**
      * @brief Preempt the currently running process
      * @param current_process The process to preempt
      */
-    virtual void preempt_process(std::shared_ptr<Process> current_process) = 0;
+    virtual void preempt_process(ProcessHandle current_process) = 0;
+
+    /**
+     * @brief Tell the scheduler how many CPUs will dispatch from it
+     *
+     * Called by the simulator before the first process is added. Schedulers with a single
+     * shared ready queue can ignore it.
+     * @param cpus Number of simulated CPUs
+     */
+    virtual void set_cpu_count(int cpus) { (void)cpus; }
+
+    /**
+     * @brief Get the next process to run on a particular CPU
+     *
+     * Defaults to get_next_process(), i.e. one queue shared by every CPU.
+     * @param cpu Index of the CPU asking for work
+     */
+    virtual std::optional<ProcessHandle> get_next_process_on(int cpu) {
+        (void)cpu;
+        return get_next_process();
+    }
+
+    /**
+     * @brief Preempt the process running on a particular CPU
+     *
+     * Defaults to preempt_process(), i.e. one queue shared by every CPU.
+     * @param current_process The process to preempt
+     * @param cpu Index of the CPU it was running on
+     */
+    virtual void preempt_process_on(ProcessHandle current_process, int cpu) {
+        (void)cpu;
+        preempt_process(current_process);
+    }
+
+    /**
+     * @brief Number of times an idle CPU took work queued on another CPU
+     */
+    virtual int steals() const { return 0; }
 
     /**
      * @brief Check if preemption is needed for the current process
@@ -81,7 +89,33 @@ public:
      * @param current_time Current simulation time
      * @return True if preemption is needed, false otherwise
      */
-    virtual bool needs_preemption(std::shared_ptr<Process> current_process, int current_time) = 0;
+    virtual bool needs_preemption(ProcessHandle current_process, int current_time) = 0;
+
+    /**
+     * @brief Number of upcoming needs_preemption checks that are certain to return false
+     *
+     * Assumes the ready queue does not change in the meantime. The event-driven simulator
+     * uses this to jump over ticks on which nothing can happen. The default of 0 disables
+     * skipping, which is always correct.
+     * @param current_process The currently running process
+     * @param current_time Time of the next check
+     * @return Number of checks that may be skipped
+     */
+    virtual int ticks_until_preemption(ProcessHandle current_process, int current_time) const {
+        (void)current_process;
+        (void)current_time;
+        return 0;
+    }
+
+    /**
+     * @brief Account for needs_preemption checks skipped by the event-driven simulator
+     * @param current_process The running process whose checks were skipped
+     * @param ticks Number of skipped checks, all of which would have returned false
+     */
+    virtual void skip_ticks(ProcessHandle current_process, int ticks) {
+        (void)current_process;
+        (void)ticks;
+    }
 
     /**
      * @brief Get the name of the scheduling algorithm
@@ -90,7 +124,44 @@ public:
     virtual std::string name() const = 0;
 
 protected:
-    std::unordered_map<int, std::shared_ptr<Process>> processes_;
+    ProcessRef process(ProcessHandle handle) { return (*table_)[handle]; }
+    const ProcessRef process(ProcessHandle handle) const {
+        return static_cast<const ProcessTable&>(*table_)[handle];
+    }
+
+    ProcessTable* table_{nullptr};
 };
 
+/**
+ * @brief Tuning knobs for make_scheduler; each algorithm reads only its own
+ */
+struct SchedulerOptions {
+    int quantum{4};           // Round Robin, Work Stealing, MLFQ top level
+    bool preemptive{true};    // Priority
+    int aging_interval{0};    // Priority: time per level gained while waiting, 0 for none
+    int target_latency{6};    // CFS scheduling period
+    int min_granularity{1};   // CFS shortest slice
+    int levels{3};            // MLFQ priority levels; quantum doubles per level
+    int boost_interval{100};  // MLFQ time between boosts to the top level, 0 for never
+};
+
+/**
+ * @brief Create a scheduler from its command-line name (rr/fcfs/sjf/srtf/prio/ws/cfs/mlfq)
+ * @param algorithm Short algorithm name
+ * @param options Algorithm parameters
+ * @return The scheduler, or nullptr if the name is unknown
+ */
+std::unique_ptr<Scheduler> make_scheduler(const std::string& algorithm,
+                                          const SchedulerOptions& options);
+
+/**
+ * @brief Create a scheduler with default options apart from quantum and preemption
+ * @param algorithm Short algorithm name
+ * @param quantum Time quantum, used by Round Robin and Work Stealing
+ * @param preemptive Whether priority scheduling may preempt
+ * @return The scheduler, or nullptr if the name is unknown
+ */
+std::unique_ptr<Scheduler> make_scheduler(const std::string& algorithm, int quantum,
+                                          bool preemptive);
+
 } // namespace cpu_scheduler 
\ No newline at end of file
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "core/event_trace.hpp"
+#include "core/latency_histogram.hpp"
+#include "core/process_source.hpp"
 #include "core/scheduler.hpp"
+#include "core/workload.hpp"
 #include <memory>
-#include <vector>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <iomanip>
+#include <vector>
 
 namespace cpu_scheduler {
 
@@ -14,35 +20,119 @@ namespace cpu_scheduler {
 struct SimulationStats {
     double avg_waiting_time{0.0};
     double avg_turnaround_time{0.0};
+    double avg_response_time{0.0};
     int total_context_switches{0};
     int completed_processes{0};
+    int makespan{0};                          // Time at which the simulation ended
+    std::vector<int> cpu_context_switches;    // Per CPU; sums to total_context_switches
+    std::vector<double> cpu_utilization;      // Per CPU, fraction of makespan spent executing
+    int migrations{0};                        // Re-dispatches onto a different CPU
+    int steals{0};                            // Work taken from another CPU's run queue
+    LatencyHistogram waiting_times;           // Per completed process
+    LatencyHistogram turnaround_times;
+    LatencyHistogram response_times;
 
     std::string to_string() const {
         std::stringstream ss;
         ss << std::fixed << std::setprecision(2)
            << "Average Waiting Time: " << avg_waiting_time << "ms\n"
            << "Average Turnaround Time: " << avg_turnaround_time << "ms\n"
+           << "Average Response Time: " << avg_response_time << "ms\n"
            << "Total Context Switches: " << total_context_switches << "\n"
            << "Completed Processes: " << completed_processes;
+        if (completed_processes > 0) {
+            ss << "\nPercentiles (p50 / p90 / p99 / p99.9 / max):"
+               << "\n  Waiting: " << percentiles(waiting_times) << "ms"
+               << "\n  Turnaround: " << percentiles(turnaround_times) << "ms"
+               << "\n  Response: " << percentiles(response_times) << "ms";
+        }
+        if (cpu_utilization.size() > 1) {
+            ss << "\nMakespan: " << makespan << "ms"
+               << "\nMigrations: " << migrations
+               << "\nSteals: " << steals;
+            for (size_t cpu = 0; cpu < cpu_utilization.size(); cpu++) {
+                ss << "\nCPU " << cpu << ": " << cpu_utilization[cpu] * 100 << "% busy, "
+                   << cpu_context_switches[cpu] << " context switches";
+            }
+        }
+        return ss.str();
+    }
+
+    static std::string percentiles(const LatencyHistogram& histogram) {
+        std::stringstream ss;
+        ss << histogram.percentile(50) << " / " << histogram.percentile(90) << " / "
+           << histogram.percentile(99) << " / " << histogram.percentile(99.9) << " / "
+           << histogram.max();
         return ss.str();
     }
 };
 
+/**
+ * @brief How the simulator advances the clock
+ */
+enum class SimulationMode {
+    TICK,          // One time unit per loop iteration (reference implementation)
+    EVENT_DRIVEN   // Jump to the next arrival, completion, quantum expiry or switch end
+};
+
 /**
  * @brief Main simulator class that manages the scheduling simulation
+ *
+ * Simulates one or more CPUs that share the scheduler's ready queue. Each time unit, every
+ * CPU in turn checks its running process for preemption and dispatches from the queue if
+ * it is free. A context switch stalls only the CPU it happens on.
  */
 class Simulator {
 public:
-    Simulator(std::unique_ptr<Scheduler> scheduler, int context_switch_overhead = 0)
+    /**
+     * @throws std::invalid_argument if cpus is less than 1
+     */
+    Simulator(std::unique_ptr<Scheduler> scheduler, int context_switch_overhead = 0,
+              SimulationMode mode = SimulationMode::EVENT_DRIVEN, int cpus = 1)
         : scheduler_(std::move(scheduler)), 
           context_switch_overhead_(context_switch_overhead),
-          next_pid_(1) {}
+          mode_(mode),
+          next_pid_(1) {
+        if (cpus < 1) {
+            throw std::invalid_argument("a simulator needs at least one CPU");
+        }
+        cpus_.resize(cpus);
+    }
 
     /**
      * @brief Add a new process to the simulation
      */
     void add_process(int arrival_time, int burst_time, int priority = 0);
 
+    /**
+     * @brief Add every process of a workload, in order
+     */
+    void add_processes(const Workload& workload);
+
+    /**
+     * @brief Add count processes read in place from a packed array, e.g. a mapped trace
+     */
+    void add_processes(const WorkloadEntry* entries, size_t count);
+
+    /**
+     * @brief Stream further processes from a source while the simulation runs
+     *
+     * Entries are pulled only once the clock reaches their arrival time, so the workload
+     * never has to be held in memory as a whole. Streamed processes are admitted after
+     * any added up front that arrive at the same time.
+     * @throws std::runtime_error from run() if the source is not sorted by arrival
+     */
+    void set_process_source(std::unique_ptr<ProcessSource> source);
+
+    /**
+     * @brief Record arrivals, dispatches, preemptions and completions while running
+     *
+     * The recorder is not owned and must outlive run(), which flushes it before
+     * returning. Pass nullptr to stop recording.
+     * @throws std::invalid_argument if the simulator has more than kMaxEventTraceCpus CPUs
+     */
+    void set_event_recorder(EventRecorder* recorder);
+
     /**
      * @brief Run the simulation until completion
      * @return Statistics from the simulation run
@@ -59,18 +149,66 @@ public:
      */
     int context_switch_overhead() const;
 
+    /**
+     * @brief Get the clock advancement mode
+     */
+    SimulationMode mode() const;
+
+    /**
+     * @brief Get the number of simulated CPUs
+     */
+    int cpu_count() const;
+
+    /**
+     * @brief Get the number of rows the process table has grown to
+     *
+     * A completed process's row is reused by the next arrival, so this is bounded by the
+     * processes added up front plus the most streamed ones alive at any one time, not by
+     * how many have been streamed in total.
+     */
+    size_t process_table_size() const;
+
 private:
+    /**
+     * @brief State of one simulated CPU
+     */
+    struct Cpu {
+        std::optional<ProcessHandle> running;
+        bool switching{false};      // Stalled in a context switch until resume_time
+        bool freed{false};          // Lost its process this tick; dispatches on the next
+        int resume_time{0};
+        int context_switches{0};
+        int migrations{0};          // Dispatches of processes that last ran on another CPU
+        long long busy_time{0};
+    };
+
     bool is_simulation_complete() const;
     void add_arrived_processes(int current_time);
+    int next_arrival_time() const;
+    void pull_from_source();
+    void record_arrival(ProcessHandle handle);
+    bool step();
+    void skip_quiet_ticks();
+    void retire(ProcessHandle handle);
+    void summarize();
 
     std::unique_ptr<Scheduler> scheduler_;
-    std::vector<std::shared_ptr<Process>> processes_;
+    ProcessTable processes_;       // Sorted by arrival once run() starts
+    size_t preloaded_processes_{0};  // Processes added before run(); streamed ones follow
+    size_t next_arrival_{0};       // First preloaded process not yet admitted
+    std::unique_ptr<ProcessSource> source_;
+    std::optional<WorkloadEntry> next_streamed_;  // Lookahead from source_
+    EventRecorder* recorder_{nullptr};
+    size_t incomplete_processes_{0};
+    SimulationStats stats_;        // Completed processes are folded in as they finish
+    long long turnaround_total_{0};
+    long long waiting_total_{0};
+    long long response_total_{0};
     int context_switch_overhead_;
+    SimulationMode mode_;
     int current_time_{0};
     int next_pid_;
-    bool in_context_switch_{false};
-    int context_switch_time_remaining_{0};
-    SimulationStats stats_;
+    std::vector<Cpu> cpus_;
 };
 
 } // namespace cpu_scheduler 
\ No newline at end of file
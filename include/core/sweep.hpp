@@ -0,0 +1,61 @@
+#pragma once
+
+#include "core/simulator.hpp"
+#include "core/workload.hpp"
+#include <string>
+#include <vector>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief One configuration of a parameter sweep
+ */
+struct SweepPoint {
+    std::string algorithm;
+    int quantum{4};
+    int context_switch_overhead{0};
+    bool preemptive{true};
+    int cpus{1};
+};
+
+/**
+ * @brief Outcome of simulating one sweep point
+ */
+struct SweepResult {
+    SweepPoint point;
+    std::string scheduler_name;
+    SimulationStats stats;
+};
+
+/**
+ * @brief Build the algorithm x quantum x overhead x CPU count grid
+ *
+ * Quanta only matter for Round Robin, Work Stealing and MLFQ, so other algorithms get one
+ * point per overhead and CPU count.
+ */
+std::vector<SweepPoint> make_sweep_grid(const std::vector<std::string>& algorithms,
+                                        const std::vector<int>& quanta,
+                                        const std::vector<int>& overheads,
+                                        bool preemptive = true,
+                                        const std::vector<int>& cpu_counts = {1});
+
+/**
+ * @brief Simulate every point of the grid on a pool of worker threads
+ *
+ * Each point gets its own Simulator; the workload is only read. Results come back in
+ * grid order regardless of which thread ran them.
+ * @param workload Processes to replay for every point
+ * @param grid Configurations to simulate
+ * @param threads Number of workers, or 0 for one per hardware thread
+ * @param options Scheduler options for everything a sweep point does not set
+ * @throws std::invalid_argument if a point names an unknown algorithm
+ */
+std::vector<SweepResult> run_sweep(const Workload& workload, const std::vector<SweepPoint>& grid,
+                                   unsigned threads = 0, const SchedulerOptions& options = {});
+
+/**
+ * @brief Render sweep results as one aligned table
+ */
+std::string format_sweep_table(const std::vector<SweepResult>& results);
+
+} // namespace cpu_scheduler
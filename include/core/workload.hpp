@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief One process of a workload description, before it is given a pid
+ */
+struct WorkloadEntry {
+    int arrival_time;
+    int burst_time;
+    int priority;
+};
+
+/**
+ * @brief A parsed workload; read-only once loaded, so it can be shared between runs
+ */
+using Workload = std::vector<WorkloadEntry>;
+
+} // namespace cpu_scheduler
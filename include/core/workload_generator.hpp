@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/process_source.hpp"
+#include "core/workload.hpp"
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief How generated processes arrive
+ */
+enum class ArrivalModel {
+    POISSON,   // Independent arrivals, exponential gaps
+    BURSTY     // Poisson clumps of a geometric number of simultaneous arrivals
+};
+
+/**
+ * @brief How generated burst times are distributed
+ */
+enum class BurstModel {
+    EXPONENTIAL,  // Memoryless, the classic M/M/1 service time
+    PARETO,       // Heavy tail: a few huge jobs among many small ones
+    BIMODAL       // Mixture of short and long exponential bursts
+};
+
+/**
+ * @brief Parameters of a synthetic workload
+ *
+ * Every model is parameterized by its mean, so switching models changes the shape of the
+ * distribution but not the offered load.
+ */
+struct GeneratorOptions {
+    uint64_t count{1000};
+    uint64_t seed{1};
+    ArrivalModel arrivals{ArrivalModel::POISSON};
+    double arrival_rate{0.1};         // Mean processes per time unit
+    double mean_clump_size{8.0};      // BURSTY: mean processes arriving together
+    BurstModel bursts{BurstModel::EXPONENTIAL};
+    double mean_burst{8.0};
+    double pareto_shape{1.5};         // PARETO: tail index, must be above 1
+    double long_burst_fraction{0.1};  // BIMODAL: share of long bursts
+    double long_burst_ratio{20.0};    // BIMODAL: long mean over short mean
+    std::vector<std::pair<int, double>> priority_mix{{0, 1.0}};  // (priority, weight)
+};
+
+/**
+ * @brief Streams a synthetic workload, drawing each process as the simulator asks for it
+ *
+ * The generator itself buffers nothing, and the simulator folds each process into its
+ * statistics and reuses its row once it finishes, so memory follows the number of
+ * processes alive at once rather than the count. Only an overloaded run, whose backlog
+ * keeps growing, needs more.
+ *
+ * Samples are drawn by inverse transform from a 64-bit Mersenne Twister, so the same seed
+ * gives the same workload on every standard library. Burst times are rounded to the
+ * nearest unit, at least 1.
+ */
+class WorkloadGenerator : public ProcessSource {
+public:
+    /**
+     * @throws std::invalid_argument if a rate, mean or weight is not positive, or the
+     *         Pareto shape is not above 1
+     */
+    explicit WorkloadGenerator(const GeneratorOptions& options);
+
+    /**
+     * @throws std::runtime_error if the arrival time outgrows the simulator's clock
+     */
+    bool next(WorkloadEntry& entry) override;
+
+private:
+    double uniform();   // In (0, 1]
+    double exponential(double mean);
+    int draw_burst();
+    int draw_priority();
+
+    GeneratorOptions options_;
+    std::mt19937_64 rng_;
+    std::vector<double> cumulative_weights_;
+    uint64_t generated_{0};
+    double clock_{0.0};
+    uint64_t clump_left_{0};  // Processes still to arrive at the current time
+};
+
+/**
+ * @brief Generate a whole workload in memory, e.g. for a sweep
+ */
+Workload generate_workload(const GeneratorOptions& options);
+
+} // namespace cpu_scheduler
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "core/process_source.hpp"
+#include "core/workload.hpp"
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+
+namespace cpu_scheduler {
+
+/**
+ * @brief Parse a JSON workload document without building a DOM
+ *
+ * Expects the `{"processes": [{"arrival_time", "burst_time", "priority"}, ...]}` schema
+ * used by the files in workloads/. Each process is handed to emit as soon as its object closes, so
+ * memory use does not depend on the size of the document.
+ *
+ * If scenario is set, the document is read as benchmarks/scenarios.json instead: a map
+ * from scenario name to a workload object, of which only the named one is read.
+ * @throws std::runtime_error on malformed input, a process missing a field or an
+ *         unknown scenario
+ */
+void read_workload(std::istream& in, const std::function<void(const WorkloadEntry&)>& emit,
+                   const std::string& scenario = "");
+
+/**
+ * @brief Load a whole JSON workload file, or one scenario of a scenarios file
+ * @throws std::runtime_error if the file cannot be read or parsed
+ */
+Workload load_workload(const std::string& filename, const std::string& scenario = "");
+
+/**
+ * @brief Streams processes from line-delimited JSON, one process object per line
+ *
+ * Lines must be sorted by arrival time. Only the current line is held in memory.
+ */
+class JsonLinesSource : public ProcessSource {
+public:
+    explicit JsonLinesSource(std::unique_ptr<std::istream> in) : in_(std::move(in)) {}
+
+    /**
+     * @throws std::runtime_error on a malformed line or an arrival out of order
+     */
+    bool next(WorkloadEntry& entry) override;
+
+private:
+    std::unique_ptr<std::istream> in_;
+    std::string line_;
+    long long line_number_{0};
+    int last_arrival_{0};
+};
+
+/**
+ * @brief Open a line-delimited JSON workload file for streaming
+ * @throws std::runtime_error if the file cannot be opened
+ */
+std::unique_ptr<ProcessSource> open_workload_stream(const std::string& filename);
+
+/**
+ * @brief True if the file name looks like line-delimited JSON (.jsonl or .ndjson)
+ */
+bool is_streaming_workload(const std::string& filename);
+
+} // namespace cpu_scheduler
@@ -7,6 +7,7 @@
 #include <memory>
 #include <map>
 #include "core/process.hpp"
+#include "core/simulator.hpp"
 
 namespace cpu_scheduler {
 
@@ -89,6 +90,12 @@ public:
         ss << "Average Response Time:    " << stats.avg_response_time << " units\n";
         ss << "Total Context Switches:   " << stats.total_context_switches << "\n";
         ss << "Completed Processes:      " << stats.completed_processes << "\n";
+        ss << "Waiting Time p50/p90/p99/p99.9/max:     "
+           << SimulationStats::percentiles(stats.waiting_times) << " units\n";
+        ss << "Turnaround Time p50/p90/p99/p99.9/max:  "
+           << SimulationStats::percentiles(stats.turnaround_times) << " units\n";
+        ss << "Response Time p50/p90/p99/p99.9/max:    "
+           << SimulationStats::percentiles(stats.response_times) << " units\n";
         ss << "CPU Utilization:         " << calculate_cpu_utilization() * 100 << "%\n";
         return ss.str();
     }
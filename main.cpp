@@ -1,14 +1,39 @@
 #include <string>
-#include <sstream>
 #include <iostream>
 
 #include "PCB.h"
 #include "disk.h"
 #include "OS.h"
+#include "commands.h"
 
 using namespace std;
 
-int main() {
+// Usage: main [lru|clock|2q|arc]
+//        main [lru|clock|2q|arc|opt] --batch script [--no-snapshots]
+// The optional policy chooses the page replacement policy, LRU by default.
+// With --batch the commands are read from the script instead of the keyboard, without prompts, and the run stops at the end of the
+// script. The script starts with the answers to the three start-up questions. --no-snapshots skips the S commands.
+int main(int argc, char* argv[]) {
+
+    std::string policy_name = "lru";
+    const char* batch_script = nullptr;
+    bool snapshots = true;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--batch" && i + 1 < argc) {
+            batch_script = argv[++i];
+        }
+        else if (argument == "--no-snapshots") {
+            snapshots = false;
+        }
+        else {
+            policy_name = argument;
+        }
+    }
+
+    if (batch_script != nullptr) {
+        return RunBatch(batch_script, policy_name, snapshots);
+    }
 
     unsigned int RAM = 0;
     unsigned int page_size = 0;
@@ -26,69 +51,23 @@ int main() {
 
     OperatingSystem OS(number_of_hard_disks, RAM, page_size);
 
+    ReplacementPolicy* policy = MakeReplacementPolicy(policy_name, page_size == 0 ? 0 : RAM / page_size);
+    if (policy == nullptr) {
+        std::cout << "Unknown page replacement policy " << policy_name << "; choose lru, clock, 2q or arc" << std::endl;
+        return 1;
+    }
+    OS.SetReplacementPolicy(policy);
+
     std::string input;
     std::getline(std::cin, input);
 
     while (1) {
-         //Shows which process is currently using the CPU and which processes are waiting in the ready-queue.
-        if (input == "S r") {
-            OS.Snapshot();
-        }
-        //Shows which processes are currently using the hard disks and which processes are waiting to use them
-        else if (input == "S i") {
-            OS.IOSnapshot();
-        }
-        //Shows the state of memory.
-        else if (input == "S m") {
-            OS.MemorySnapshot();
-        }
-        // Creates a new pcb and places it at end of ready queue, or in the CPU if the ready queue is empty.
-        else if (input == "A") {
-            OS.CreateProcess();
-        }
-        //The currently running process has spent a time quantum using the CPU. 
-        else if (input == "Q") {
-            OS.CPUToReadyQueue();
-        }
-        //The process using the CPU forks a child.The child is placed in the end of the ready - queue.
-        else if (input == "fork") {
-            OS.Fork();
-        }
-        //The process that is currently using the CPU terminates.
-        else if (input == "exit") {
-            OS.Exit();
-        }
-        //The process wants to pause and wait for any of its child processes to terminate.
-        else if (input == "wait") {
-            OS.Wait();
-        }
-        
-        // For other commands, parse input
-        std::stringstream in_stream(input);
-        string first_word;
-        in_stream >> first_word;
+        ExecuteCommand(OS, input.data(), input.data() + input.size(), snapshots);
 
-        if (first_word == "d" || first_word == "D" || first_word == "m") {
-            int second_word;
-            in_stream >> second_word;
-            //The process that currently uses the CPU requests the hard disk #number. 
-            //It wants to read or write file file _name.
-            if (first_word == "d") {
-                string third_word;
-                in_stream >> third_word;
-                OS.RequestDisk(second_word, third_word);
-            }
-            else if (first_word == "D") { // "D number") {
-                // The hard disk #number has finished the work for one process.
-                OS.RemoveProcessFromDisk(second_word);
-            }
-            //The process that is currently using the CPU requests a memory operation for the logical address.
-            else if (first_word == "m") { // == "m address") {
-                OS.RequestMemoryOperation(second_word);
-            }
-        }       
         // Get next line of input from user
         std::cout << endl;
-        std::getline(std::cin, input);
+        if (!std::getline(std::cin, input)) {
+            break;
+        }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,469 @@
+#ifndef REPLACEMENT_H
+#define REPLACEMENT_H
+
+#include <algorithm>
+#include <climits>
+#include <list>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Identifies a page of a process, so a page can be tracked after it leaves its frame.
+inline unsigned long long PageKey(const int pid, const int page) {
+    return (static_cast<unsigned long long>(static_cast<unsigned int>(pid)) << 32) | static_cast<unsigned int>(page);
+}
+
+// Decides which used frame gives up its page when memory is full.
+// The operating system owns the frame table and fills empty frames itself; the policy is told about every reference and only
+// chooses a victim once no frame is empty. Frames are identified by their index in the frame table.
+class ReplacementPolicy {
+    public:
+        virtual ~ReplacementPolicy() {}
+
+        // Name shown in the replacement statistics
+        virtual std::string Name() const = 0;
+
+        // The page in frame was referenced again
+        virtual void Hit(const int frame) = 0;
+
+        // Every frame is used and the page key must be loaded. Returns the frame to replace, which the policy stops tracking.
+        virtual int Victim(const unsigned long long key) = 0;
+
+        // The page key was loaded into frame, which was empty or has just been chosen as a victim
+        virtual void Insert(const int frame, const unsigned long long key) = 0;
+
+        // The page in frame was dropped because its process terminated
+        virtual void Remove(const int frame) = 0;
+};
+
+// Doubly linked lists threaded through frame indices. Each frame is on at most one list at a time.
+class FrameLists {
+    public:
+        struct List {
+            int head;       // Oldest frame, -1 if empty
+            int tail;       // Newest frame, -1 if empty
+            int size;
+
+            List() : head(-1), tail(-1), size(0) {}
+        };
+
+        void PushBack(List & list, const int frame) {
+            Grow(frame);
+            prev[frame] = list.tail;
+            next[frame] = -1;
+            if (list.tail >= 0) {
+                next[list.tail] = frame;
+            }
+            else {
+                list.head = frame;
+            }
+            list.tail = frame;
+            list.size++;
+        }
+
+        void Unlink(List & list, const int frame) {
+            if (prev[frame] >= 0) {
+                next[prev[frame]] = next[frame];
+            }
+            else {
+                list.head = next[frame];
+            }
+            if (next[frame] >= 0) {
+                prev[next[frame]] = prev[frame];
+            }
+            else {
+                list.tail = prev[frame];
+            }
+            prev[frame] = -1;
+            next[frame] = -1;
+            list.size--;
+        }
+
+    private:
+        void Grow(const int frame) {
+            if (frame >= static_cast<int>(prev.size())) {
+                prev.resize(frame + 1, -1);
+                next.resize(frame + 1, -1);
+            }
+        }
+
+        std::vector<int> prev;
+        std::vector<int> next;
+};
+
+// Keys of pages that are no longer resident, oldest first, with O(1) lookup. Used for the history lists of 2Q and ARC.
+class GhostList {
+    public:
+        bool Contains(const unsigned long long key) const {
+            return index.count(key) > 0;
+        }
+
+        void PushBack(const unsigned long long key) {
+            order.push_back(key);
+            index[key] = --order.end();
+        }
+
+        void Erase(const unsigned long long key) {
+            auto found = index.find(key);
+            if (found != index.end()) {
+                order.erase(found->second);
+                index.erase(found);
+            }
+        }
+
+        void PopFront() {
+            if (!order.empty()) {
+                index.erase(order.front());
+                order.pop_front();
+            }
+        }
+
+        int Size() const {
+            return static_cast<int>(order.size());
+        }
+
+    private:
+        std::list<unsigned long long> order;
+        std::unordered_map<unsigned long long, std::list<unsigned long long>::iterator> index;
+};
+
+// Least recently used: evicts the page whose last reference is oldest.
+class LruPolicy : public ReplacementPolicy {
+    public:
+        std::string Name() const { return "LRU"; }
+
+        void Hit(const int frame) {
+            lists.Unlink(recency, frame);
+            lists.PushBack(recency, frame);
+        }
+
+        int Victim(const unsigned long long) {
+            int frame = recency.head;
+            lists.Unlink(recency, frame);
+            return frame;
+        }
+
+        void Insert(const int frame, const unsigned long long) {
+            lists.PushBack(recency, frame);
+        }
+
+        void Remove(const int frame) {
+            lists.Unlink(recency, frame);
+        }
+
+    private:
+        FrameLists lists;
+        FrameLists::List recency;   // Least recently used at the head
+};
+
+// CLOCK, or second chance: a hand sweeps the frames, clearing reference bits, and evicts the first page not referenced since the
+// hand last passed it. Approximates LRU with one bit per frame.
+class ClockPolicy : public ReplacementPolicy {
+    public:
+        ClockPolicy() : hand(0) {}
+
+        std::string Name() const { return "CLOCK"; }
+
+        void Hit(const int frame) {
+            referenced[frame] = 1;
+        }
+
+        int Victim(const unsigned long long) {
+            // Every frame is used, so this stops within two sweeps
+            while (true) {
+                int frame = hand;
+                hand = (hand + 1) % static_cast<int>(referenced.size());
+                if (!used[frame]) {
+                    continue;
+                }
+                if (referenced[frame]) {
+                    referenced[frame] = 0;
+                }
+                else {
+                    used[frame] = 0;
+                    return frame;
+                }
+            }
+        }
+
+        void Insert(const int frame, const unsigned long long) {
+            if (frame >= static_cast<int>(used.size())) {
+                used.resize(frame + 1, 0);
+                referenced.resize(frame + 1, 0);
+            }
+            used[frame] = 1;
+            referenced[frame] = 1;
+        }
+
+        void Remove(const int frame) {
+            used[frame] = 0;
+            referenced[frame] = 0;
+        }
+
+    private:
+        std::vector<char> used;
+        std::vector<char> referenced;
+        int hand;
+};
+
+// 2Q (Johnson and Shasha): pages referenced once wait in a small FIFO, and only pages referenced again after leaving it are
+// promoted to the main LRU list, so one pass over a large region cannot flush the pages that are used repeatedly.
+class TwoQueuePolicy : public ReplacementPolicy {
+    public:
+        // The FIFO gets a quarter of memory and the history of pages evicted from it covers half, as recommended by the paper
+        explicit TwoQueuePolicy(const int number_of_frames) :
+            max_fifo(std::max(1, number_of_frames / 4)),
+            max_history(std::max(1, number_of_frames / 2)) {}
+
+        std::string Name() const { return "2Q"; }
+
+        void Hit(const int frame) {
+            if (in_main[frame]) {
+                lists.Unlink(main, frame);
+                lists.PushBack(main, frame);
+            }
+        }
+
+        int Victim(const unsigned long long) {
+            int frame;
+            if (fifo.size > max_fifo || main.size == 0) {
+                frame = fifo.head;
+                lists.Unlink(fifo, frame);
+                history.PushBack(keys[frame]);
+                if (history.Size() > max_history) {
+                    history.PopFront();
+                }
+            }
+            else {
+                frame = main.head;
+                lists.Unlink(main, frame);
+            }
+            return frame;
+        }
+
+        void Insert(const int frame, const unsigned long long key) {
+            if (frame >= static_cast<int>(keys.size())) {
+                keys.resize(frame + 1, 0);
+                in_main.resize(frame + 1, 0);
+            }
+            keys[frame] = key;
+            if (history.Contains(key)) {
+                history.Erase(key);
+                in_main[frame] = 1;
+                lists.PushBack(main, frame);
+            }
+            else {
+                in_main[frame] = 0;
+                lists.PushBack(fifo, frame);
+            }
+        }
+
+        void Remove(const int frame) {
+            lists.Unlink(in_main[frame] ? main : fifo, frame);
+        }
+
+    private:
+        const int max_fifo;
+        const int max_history;
+        FrameLists lists;
+        FrameLists::List fifo;      // A1in: resident pages referenced once, oldest at the head
+        FrameLists::List main;      // Am: resident pages referenced again, least recently used at the head
+        GhostList history;          // A1out: pages recently evicted from the FIFO
+        std::vector<unsigned long long> keys;   // Page held by each frame
+        std::vector<char> in_main;
+};
+
+// Adaptive Replacement Cache (Megiddo and Modha): splits memory between pages seen once and pages seen at least twice, and moves
+// the split towards whichever side's recently evicted pages are being asked for again.
+class ArcPolicy : public ReplacementPolicy {
+    public:
+        explicit ArcPolicy(const int number_of_frames) :
+            capacity(std::max(1, number_of_frames)),
+            target(0),
+            adapted(false) {}
+
+        std::string Name() const { return "ARC"; }
+
+        void Hit(const int frame) {
+            lists.Unlink(in_frequent[frame] ? frequent : recent, frame);
+            in_frequent[frame] = 1;
+            lists.PushBack(frequent, frame);
+        }
+
+        int Victim(const unsigned long long key) {
+            Adapt(key);
+            bool in_history = recent_history.Contains(key) || frequent_history.Contains(key);
+            if (!in_history) {
+                if (recent.size + recent_history.Size() >= capacity) {
+                    // Pages seen once fill memory on their own: drop the oldest outright
+                    if (recent_history.Size() == 0) {
+                        int frame = recent.head;
+                        lists.Unlink(recent, frame);
+                        return frame;
+                    }
+                    recent_history.PopFront();
+                }
+                else if (recent.size + frequent.size + recent_history.Size() + frequent_history.Size() >= 2 * capacity) {
+                    frequent_history.PopFront();
+                }
+            }
+            return Replace(frequent_history.Contains(key));
+        }
+
+        void Insert(const int frame, const unsigned long long key) {
+            if (frame >= static_cast<int>(keys.size())) {
+                keys.resize(frame + 1, 0);
+                in_frequent.resize(frame + 1, 0);
+            }
+            Adapt(key);
+            adapted = false;
+            keys[frame] = key;
+
+            if (recent_history.Contains(key) || frequent_history.Contains(key)) {
+                recent_history.Erase(key);
+                frequent_history.Erase(key);
+                in_frequent[frame] = 1;
+                lists.PushBack(frequent, frame);
+            }
+            else {
+                // Loaded into an empty frame: keep the history within its bounds
+                if (recent.size + recent_history.Size() >= capacity) {
+                    recent_history.PopFront();
+                }
+                else if (recent.size + frequent.size + recent_history.Size() + frequent_history.Size() >= 2 * capacity) {
+                    frequent_history.PopFront();
+                }
+                in_frequent[frame] = 0;
+                lists.PushBack(recent, frame);
+            }
+        }
+
+        void Remove(const int frame) {
+            lists.Unlink(in_frequent[frame] ? frequent : recent, frame);
+        }
+
+    private:
+        // Moves the target size of the recent list once per miss, by the ratio of the history list sizes
+        void Adapt(const unsigned long long key) {
+            if (adapted) {
+                return;
+            }
+            adapted = true;
+            if (recent_history.Contains(key)) {
+                double step = std::max(1.0, static_cast<double>(frequent_history.Size()) / recent_history.Size());
+                target = std::min(static_cast<double>(capacity), target + step);
+            }
+            else if (frequent_history.Contains(key)) {
+                double step = std::max(1.0, static_cast<double>(recent_history.Size()) / frequent_history.Size());
+                target = std::max(0.0, target - step);
+            }
+        }
+
+        // Evicts from the recent list if it is over its target, otherwise from the frequent list, remembering the page
+        int Replace(const bool key_in_frequent_history) {
+            bool from_recent = recent.size > 0 &&
+                (recent.size > target || (key_in_frequent_history && recent.size == static_cast<int>(target)) || frequent.size == 0);
+            int frame;
+            if (from_recent) {
+                frame = recent.head;
+                lists.Unlink(recent, frame);
+                recent_history.PushBack(keys[frame]);
+            }
+            else {
+                frame = frequent.head;
+                lists.Unlink(frequent, frame);
+                frequent_history.PushBack(keys[frame]);
+            }
+            return frame;
+        }
+
+        const int capacity;
+        double target;                  // Size the recent list is steered towards
+        bool adapted;                   // Target already moved for the current miss
+        FrameLists lists;
+        FrameLists::List recent;        // T1: resident pages seen once, least recent at the head
+        FrameLists::List frequent;      // T2: resident pages seen at least twice
+        GhostList recent_history;       // B1: pages evicted from T1
+        GhostList frequent_history;     // B2: pages evicted from T2
+        std::vector<unsigned long long> keys;
+        std::vector<char> in_frequent;
+};
+
+// Belady's optimal policy: evicts the page whose next reference is furthest in the future. It needs the whole reference string
+// in advance, so it is only usable offline, as a lower bound on the misses of any real policy. The references made must match
+// the string it was given.
+class OptimalPolicy : public ReplacementPolicy {
+    public:
+        explicit OptimalPolicy(const std::vector<unsigned long long> & reference_string) :
+            next_use(reference_string.size()),
+            position(0) {
+            // Scan backwards, remembering where each page is referenced next
+            std::unordered_map<unsigned long long, long long> upcoming;
+            for (long long i = static_cast<long long>(reference_string.size()) - 1; i >= 0; i--) {
+                auto found = upcoming.find(reference_string[i]);
+                next_use[i] = found == upcoming.end() ? LLONG_MAX : found->second;
+                upcoming[reference_string[i]] = i;
+            }
+        }
+
+        std::string Name() const { return "OPT"; }
+
+        void Hit(const int frame) {
+            Remove(frame);
+            Track(frame);
+        }
+
+        int Victim(const unsigned long long) {
+            auto furthest = --by_next_use.end();
+            int frame = furthest->second;
+            by_next_use.erase(furthest);
+            return frame;
+        }
+
+        void Insert(const int frame, const unsigned long long) {
+            Track(frame);
+        }
+
+        void Remove(const int frame) {
+            by_next_use.erase(std::make_pair(frame_next_use[frame], frame));
+        }
+
+    private:
+        // Files the frame under the next use of the current reference and moves on to the next one
+        void Track(const int frame) {
+            if (frame >= static_cast<int>(frame_next_use.size())) {
+                frame_next_use.resize(frame + 1, LLONG_MAX);
+            }
+            long long next = position < next_use.size() ? next_use[position] : LLONG_MAX;
+            position++;
+            frame_next_use[frame] = next;
+            by_next_use.insert(std::make_pair(next, frame));
+        }
+
+        std::vector<long long> next_use;                // For each reference, the index of the next one to the same page
+        size_t position;                                // Index of the current reference
+        std::vector<long long> frame_next_use;
+        std::set<std::pair<long long, int> > by_next_use;
+};
+
+// Returns a new policy for the name lru, clock, 2q or arc, or nullptr for any other name.
+// OPT needs the reference string, so it is constructed directly.
+inline ReplacementPolicy* MakeReplacementPolicy(const std::string & name, const int number_of_frames) {
+    if (name == "lru") {
+        return new LruPolicy{};
+    }
+    if (name == "clock") {
+        return new ClockPolicy{};
+    }
+    if (name == "2q") {
+        return new TwoQueuePolicy{ number_of_frames };
+    }
+    if (name == "arc") {
+        return new ArcPolicy{ number_of_frames };
+    }
+    return nullptr;
+}
+
+#endif // REPLACEMENT_H
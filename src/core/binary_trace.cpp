@@ -0,0 +1,91 @@
+#include "core/binary_trace.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cpu_scheduler {
+
+void write_binary_trace(const std::string& filename, Workload workload) {
+    std::stable_sort(workload.begin(), workload.end(),
+        [](const WorkloadEntry& a, const WorkloadEntry& b) {
+            return a.arrival_time < b.arrival_time;
+        });
+
+    BinaryTraceHeader header{};
+    std::memcpy(header.magic, kBinaryTraceMagic, sizeof(header.magic));
+    header.version = kBinaryTraceVersion;
+    header.record_size = sizeof(WorkloadEntry);
+    header.record_count = workload.size();
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(workload.data()),
+              static_cast<std::streamsize>(workload.size() * sizeof(WorkloadEntry)));
+    if (!out) {
+        throw std::runtime_error("cannot write " + filename);
+    }
+}
+
+bool is_binary_trace(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[sizeof(kBinaryTraceMagic)] = {};
+    in.read(magic, sizeof(magic));
+    return in && std::memcmp(magic, kBinaryTraceMagic, sizeof(magic)) == 0;
+}
+
+MappedTrace::MappedTrace(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(BinaryTraceHeader)) {
+        ::close(fd);
+        throw std::runtime_error(filename + " is too short to be a binary trace");
+    }
+    length_ = static_cast<size_t>(st.st_size);
+    data_ = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("cannot map " + filename);
+    }
+    // Records are consumed front to back
+    ::madvise(data_, length_, MADV_SEQUENTIAL);
+
+    const auto* header = static_cast<const BinaryTraceHeader*>(data_);
+    const char* error = nullptr;
+    if (std::memcmp(header->magic, kBinaryTraceMagic, sizeof(header->magic)) != 0) {
+        error = " is not a binary trace";
+    } else if (is_byte_swapped(header->version, kBinaryTraceVersion)) {
+        error = " was written on a big-endian host";
+    } else if (header->version != kBinaryTraceVersion) {
+        error = " has an unsupported trace version";
+    } else if (header->record_size != sizeof(WorkloadEntry) ||
+               header->record_count > (length_ - sizeof(BinaryTraceHeader)) / sizeof(WorkloadEntry)) {
+        error = " is truncated or has a bad record size";
+    }
+    if (error) {
+        ::munmap(data_, length_);
+        data_ = nullptr;
+        throw std::runtime_error(filename + error);
+    }
+
+    records_ = reinterpret_cast<const WorkloadEntry*>(static_cast<const char*>(data_) +
+                                                      sizeof(BinaryTraceHeader));
+    count_ = static_cast<size_t>(header->record_count);
+}
+
+MappedTrace::~MappedTrace() {
+    if (data_) {
+        ::munmap(data_, length_);
+    }
+}
+
+} // namespace cpu_scheduler
@@ -0,0 +1,126 @@
+#include "core/chrome_trace.hpp"
+#include <algorithm>
+
+namespace cpu_scheduler {
+
+namespace {
+
+// In CPU mode arrivals belong to no CPU, so they get a row of their own
+constexpr int kArrivalsTrack = -1;
+
+} // namespace
+
+ChromeTraceWriter::ChromeTraceWriter(std::ostream& out, ChromeTraceTracks tracks, int time_scale)
+    : out_(out), tracks_(tracks), time_scale_(std::max(time_scale, 1)) {
+    out_ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+}
+
+ChromeTraceWriter::~ChromeTraceWriter() {
+    finish();
+}
+
+void ChromeTraceWriter::write(const TraceEvent* events, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        write_event(events[i]);
+    }
+}
+
+void ChromeTraceWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+    out_ << "\n]}\n";
+    out_.flush();
+}
+
+void ChromeTraceWriter::write_event(const TraceEvent& event) {
+    int cpu = event.cpu;
+    switch (event.kind) {
+    case TraceEventKind::ARRIVE: {
+        int tid = tracks_ == ChromeTraceTracks::CPU ? kArrivalsTrack : event.pid;
+        name_track(tid);
+        begin_record();
+        out_ << "{\"name\":\"P" << event.pid << " arrives\",\"ph\":\"i\",\"s\":\"t\",\"ts\":"
+             << timestamp(event.time) << ",\"pid\":0,\"tid\":" << tid << "}";
+        break;
+    }
+    case TraceEventKind::START:
+        // Only arrivals are off-CPU; a start on no CPU has no row to go in
+        if (cpu < 0) {
+            break;
+        }
+        if (cpu >= static_cast<int>(slices_.size())) {
+            slices_.resize(cpu + 1);
+        }
+        slices_[cpu] = Slice{true, event.pid, event.time};
+        break;
+    case TraceEventKind::PREEMPT:
+        close_slice(cpu, event.time, "preempt");
+        break;
+    case TraceEventKind::COMPLETE:
+        close_slice(cpu, event.time, "complete");
+        break;
+    }
+}
+
+void ChromeTraceWriter::close_slice(int cpu, int end, const char* reason) {
+    if (cpu < 0 || cpu >= static_cast<int>(slices_.size()) || !slices_[cpu].open) {
+        return;
+    }
+    Slice& slice = slices_[cpu];
+    slice.open = false;
+
+    // A process preempted before its switch-in overhead ended never ran
+    if (end <= slice.start) {
+        return;
+    }
+
+    int tid = tracks_ == ChromeTraceTracks::CPU ? cpu : slice.pid;
+    name_track(tid);
+    begin_record();
+    out_ << "{\"name\":\"";
+    if (tracks_ == ChromeTraceTracks::CPU) {
+        out_ << 'P' << slice.pid;
+    } else {
+        out_ << "CPU " << cpu;
+    }
+    out_ << "\",\"cat\":\"run\",\"ph\":\"X\",\"ts\":" << timestamp(slice.start)
+         << ",\"dur\":" << timestamp(end - slice.start) << ",\"pid\":0,\"tid\":" << tid
+         << ",\"args\":{\"pid\":" << slice.pid << ",\"cpu\":" << cpu << ",\"end\":\""
+         << reason << "\"}}";
+}
+
+void ChromeTraceWriter::name_track(int tid) {
+    size_t index = static_cast<size_t>(tid + 1);
+    if (index < named_.size() && named_[index]) {
+        return;
+    }
+    if (index >= named_.size()) {
+        named_.resize(index + 1, false);
+    }
+    named_[index] = true;
+
+    begin_record();
+    out_ << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid
+         << ",\"args\":{\"name\":\"";
+    if (tid == kArrivalsTrack && tracks_ == ChromeTraceTracks::CPU) {
+        out_ << "Arrivals";
+    } else if (tracks_ == ChromeTraceTracks::CPU) {
+        out_ << "CPU " << tid;
+    } else {
+        out_ << 'P' << tid;
+    }
+    out_ << "\"}}";
+    // Keep rows in CPU or pid order rather than the order they first appear
+    begin_record();
+    out_ << "{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid
+         << ",\"args\":{\"sort_index\":" << tid << "}}";
+}
+
+void ChromeTraceWriter::begin_record() {
+    out_ << (first_ ? "\n" : ",\n");
+    first_ = false;
+}
+
+} // namespace cpu_scheduler
@@ -0,0 +1,72 @@
+#include "core/event_trace.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace cpu_scheduler {
+
+BinaryEventTraceWriter::BinaryEventTraceWriter(const std::string& filename)
+    : filename_(filename), out_(filename, std::ios::binary | std::ios::trunc) {
+    BinaryTraceHeader header{};
+    std::memcpy(header.magic, kEventTraceMagic, sizeof(header.magic));
+    header.version = kEventTraceVersion;
+    header.record_size = sizeof(TraceEvent);
+    header.record_count = 0;
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out_) {
+        throw std::runtime_error("cannot write " + filename_);
+    }
+}
+
+void BinaryEventTraceWriter::write(const TraceEvent* events, size_t count) {
+    out_.write(reinterpret_cast<const char*>(events),
+               static_cast<std::streamsize>(count * sizeof(TraceEvent)));
+    count_ += count;
+
+    // Patch the count in place so the file is valid after every batch
+    out_.seekp(offsetof(BinaryTraceHeader, record_count));
+    out_.write(reinterpret_cast<const char*>(&count_), sizeof(count_));
+    out_.seekp(0, std::ios::end);
+    out_.flush();
+    if (!out_) {
+        throw std::runtime_error("cannot write " + filename_);
+    }
+}
+
+std::vector<TraceEvent> read_event_trace(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open " + filename);
+    }
+
+    BinaryTraceHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, kEventTraceMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(filename + " is not an event trace");
+    }
+    if (is_byte_swapped(header.version, kEventTraceVersion)) {
+        throw std::runtime_error(filename + " was written on a big-endian host");
+    }
+    if (header.version != kEventTraceVersion) {
+        throw std::runtime_error(filename + " has an unsupported trace version");
+    }
+    if (header.record_size != sizeof(TraceEvent)) {
+        throw std::runtime_error(filename + " has a bad record size");
+    }
+    // The count comes from the file, so check it against the bytes there before allocating
+    in.seekg(0, std::ios::end);
+    const auto length = static_cast<uint64_t>(in.tellg());
+    in.seekg(sizeof(header));
+    if (!in || header.record_count > (length - sizeof(header)) / sizeof(TraceEvent)) {
+        throw std::runtime_error(filename + " is truncated");
+    }
+
+    std::vector<TraceEvent> events(static_cast<size_t>(header.record_count));
+    in.read(reinterpret_cast<char*>(events.data()),
+            static_cast<std::streamsize>(events.size() * sizeof(TraceEvent)));
+    if (!in) {
+        throw std::runtime_error(filename + " is truncated");
+    }
+    return events;
+}
+
+} // namespace cpu_scheduler
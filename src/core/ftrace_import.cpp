@@ -0,0 +1,346 @@
+#include "core/ftrace_import.hpp"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cpu_scheduler {
+
+namespace {
+
+constexpr int kNormalPrio = 120;  // Kernel prio of a nice 0 task
+
+bool ends_with(std::string_view text, std::string_view suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool parse_int(std::string_view text, int& value) {
+    if (text.empty() || text.size() > 9) {
+        return false;
+    }
+    int result = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        result = result * 10 + (c - '0');
+    }
+    value = result;
+    return true;
+}
+
+// "12345.678901" seconds to nanoseconds, without going through floating point
+bool parse_timestamp(std::string_view text, long long& nanoseconds) {
+    size_t dot = text.find('.');
+    std::string_view whole = text.substr(0, dot);
+    std::string_view fraction = dot == std::string_view::npos ? std::string_view{}
+                                                             : text.substr(dot + 1);
+    if (whole.empty() || whole.size() > 12 || fraction.size() > 9) {
+        return false;
+    }
+
+    long long seconds = 0;
+    for (char c : whole) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        seconds = seconds * 10 + (c - '0');
+    }
+    long long sub = 0;
+    for (size_t i = 0; i < 9; i++) {
+        char c = i < fraction.size() ? fraction[i] : '0';
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        sub = sub * 10 + (c - '0');
+    }
+    nanoseconds = seconds * 1000000000LL + sub;
+    return true;
+}
+
+// The key=value fields of sched_switch and sched_wakeup that the importer uses
+struct SchedFields {
+    int pid{-1};
+    int prio{kNormalPrio};
+    int prev_pid{-1};
+    int prev_prio{kNormalPrio};
+    std::string_view prev_state;
+    int next_pid{-1};
+    int next_prio{kNormalPrio};
+};
+
+SchedFields parse_fields(std::string_view text) {
+    SchedFields fields;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find(' ', pos);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        std::string_view token = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        size_t equals = token.find('=');
+        if (equals == std::string_view::npos) {
+            continue;
+        }
+        std::string_view key = token.substr(0, equals);
+        std::string_view value = token.substr(equals + 1);
+        if (key == "pid") {
+            parse_int(value, fields.pid);
+        } else if (key == "prio") {
+            parse_int(value, fields.prio);
+        } else if (key == "prev_pid") {
+            parse_int(value, fields.prev_pid);
+        } else if (key == "prev_prio") {
+            parse_int(value, fields.prev_prio);
+        } else if (key == "prev_state") {
+            fields.prev_state = value;
+        } else if (key == "next_pid") {
+            parse_int(value, fields.next_pid);
+        } else if (key == "next_prio") {
+            parse_int(value, fields.next_prio);
+        }
+    }
+    return fields;
+}
+
+} // namespace
+
+FtraceSource::FtraceSource(const std::string& filename, int time_unit_us,
+                           long long split_after_us)
+    : time_unit_ns_(std::max(time_unit_us, 1) * 1000LL),
+      split_after_ns_(std::max(split_after_us, 0LL) * 1000) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("cannot read " + filename);
+    }
+    length_ = static_cast<size_t>(st.st_size);
+    if (length_ > 0) {
+        data_ = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data_ == MAP_FAILED) {
+            data_ = nullptr;
+            ::close(fd);
+            throw std::runtime_error("cannot map " + filename);
+        }
+        ::madvise(data_, length_, MADV_SEQUENTIAL);
+        text_ = std::string_view(static_cast<const char*>(data_), length_);
+    }
+    ::close(fd);
+}
+
+FtraceSource::~FtraceSource() {
+    if (data_) {
+        ::munmap(data_, length_);
+    }
+}
+
+bool FtraceSource::next(WorkloadEntry& entry) {
+    while (true) {
+        // A finished burst can go once no burst still open arrived before it
+        if (!finished_.empty() &&
+            (at_end_ || awake_arrivals_.empty() ||
+             finished_.top().arrival <= awake_arrivals_.begin()->first)) {
+            entry = to_entry(finished_.top());
+            finished_.pop();
+            return true;
+        }
+        if (at_end_) {
+            return false;
+        }
+        if (offset_ >= text_.size()) {
+            drain_at_end();
+            at_end_ = true;
+            continue;
+        }
+
+        size_t end = text_.find('\n', offset_);
+        if (end == std::string_view::npos) {
+            end = text_.size();
+        }
+        std::string_view line = text_.substr(offset_, end - offset_);
+        offset_ = end + 1;
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (parse_line(line)) {
+            events_++;
+        }
+    }
+}
+
+bool FtraceSource::parse_line(std::string_view line) {
+    if (line.empty() || line.front() == '#') {
+        return false;
+    }
+
+    // "<comm>-<pid> [cpu] <flags> <secs>.<usecs>: <event>: <fields>" from ftrace, or
+    // "<comm> <pid> [cpu] <secs>.<usecs>: sched:<event>: <fields>" from perf
+    size_t cpu_end = line.find("] ");
+    if (cpu_end == std::string_view::npos) {
+        return false;
+    }
+    size_t time_end = line.find(": ", cpu_end);
+    if (time_end == std::string_view::npos) {
+        return false;
+    }
+    size_t time_start = line.rfind(' ', time_end - 1);
+    time_start = time_start == std::string_view::npos ? 0 : time_start + 1;
+    size_t event_start = time_end + 2;
+    size_t event_end = line.find(": ", event_start);
+    if (event_end == std::string_view::npos) {
+        return false;
+    }
+
+    std::string_view event = line.substr(event_start, event_end - event_start);
+    bool is_switch = ends_with(event, "sched_switch");
+    bool is_wakeup = ends_with(event, "sched_wakeup") || ends_with(event, "sched_wakeup_new");
+    long long time = 0;
+    if ((!is_switch && !is_wakeup) ||
+        !parse_timestamp(line.substr(time_start, time_end - time_start), time)) {
+        return false;
+    }
+
+    if (first_time_ < 0) {
+        first_time_ = time;
+    }
+    time = std::max(time - first_time_, 0LL);
+    last_time_ = std::max(last_time_, time);
+    split_long_bursts(time);
+
+    SchedFields fields = parse_fields(line.substr(event_end + 2));
+    if (is_switch) {
+        switch_out(fields.prev_pid, fields.prev_state, time);
+        switch_in(fields.next_pid, fields.next_prio, time);
+    } else {
+        wake(fields.pid, fields.prio, time);
+    }
+    return true;
+}
+
+void FtraceSource::wake(int pid, int prio, long long time) {
+    if (pid <= 0) {
+        return;
+    }
+    Task& task = tasks_[pid];
+    if (task.awake) {
+        return;
+    }
+    task.awake = true;
+    task.arrival = time;
+    task.ran = 0;
+    task.priority = prio - kNormalPrio;
+    task.pending = awake_arrivals_.emplace(time, pid).first;
+}
+
+void FtraceSource::switch_out(int pid, std::string_view state, long long time) {
+    if (pid <= 0) {
+        return;
+    }
+    auto it = tasks_.find(pid);
+    if (it == tasks_.end()) {
+        // On a CPU since before the trace started; its first stretch is unknown
+        return;
+    }
+    Task& task = it->second;
+    if (task.on_cpu_since >= 0) {
+        task.ran += time - task.on_cpu_since;
+        task.on_cpu_since = -1;
+    }
+    // R or R+ means preempted while runnable, so the burst goes on
+    if (task.awake && (state.empty() || state.front() != 'R')) {
+        finish_burst(pid, task);
+    }
+}
+
+void FtraceSource::switch_in(int pid, int prio, long long time) {
+    if (pid <= 0) {
+        return;
+    }
+    wake(pid, prio, time);
+    tasks_[pid].on_cpu_since = time;
+}
+
+void FtraceSource::split_long_bursts(long long time) {
+    // Cut the oldest open burst until none has been open longer than the horizon, so a
+    // task that never sleeps cannot hold back the bursts behind it
+    while (split_after_ns_ > 0 && !awake_arrivals_.empty() &&
+           time - awake_arrivals_.begin()->first > split_after_ns_) {
+        int pid = awake_arrivals_.begin()->second;
+        Task& task = tasks_[pid];
+        if (task.on_cpu_since >= 0) {
+            task.ran += time - task.on_cpu_since;
+            task.on_cpu_since = time;
+        }
+        if (task.ran > 0) {
+            finished_.push(Burst{task.arrival, next_seq_++, task.ran, task.priority});
+        }
+        awake_arrivals_.erase(task.pending);
+        task.arrival = time;
+        task.ran = 0;
+        task.pending = awake_arrivals_.emplace(time, pid).first;
+    }
+}
+
+void FtraceSource::finish_burst(int pid, Task& task) {
+    task.awake = false;
+    awake_arrivals_.erase(task.pending);
+    if (task.ran > 0) {
+        finished_.push(Burst{task.arrival, next_seq_++, task.ran, task.priority});
+    }
+    task.ran = 0;
+    // Asleep and off the CPU: nothing left to track until it wakes again
+    if (task.on_cpu_since < 0) {
+        tasks_.erase(pid);
+    }
+}
+
+void FtraceSource::drain_at_end() {
+    // Bursts cut off by the end of the trace keep the time they have run
+    for (auto& [pid, task] : tasks_) {
+        if (task.on_cpu_since >= 0) {
+            task.ran += last_time_ - task.on_cpu_since;
+            task.on_cpu_since = -1;
+        }
+    }
+    // Finish them in (arrival, pid) order, so bursts arriving together come out the same
+    // way whatever the hash order of tasks_
+    std::vector<std::pair<long long, int>> open(awake_arrivals_.begin(), awake_arrivals_.end());
+    for (const auto& [arrival, pid] : open) {
+        finish_burst(pid, tasks_[pid]);
+    }
+    tasks_.clear();
+}
+
+WorkloadEntry FtraceSource::to_entry(const Burst& burst) const {
+    long long arrival = burst.arrival / time_unit_ns_;
+    long long length = std::max(1LL, (burst.ran + time_unit_ns_ / 2) / time_unit_ns_);
+    if (arrival > std::numeric_limits<int>::max() || length > std::numeric_limits<int>::max()) {
+        throw std::runtime_error("trace is too long for the simulator clock; "
+                                 "use a larger time unit");
+    }
+    return WorkloadEntry{static_cast<int>(arrival), static_cast<int>(length), burst.priority};
+}
+
+bool is_ftrace(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char head[4096];
+    in.read(head, sizeof(head));
+    std::string_view text(head, static_cast<size_t>(in.gcount()));
+    return text.rfind("# tracer:", 0) == 0 || text.find("sched_switch: ") != std::string_view::npos ||
+           text.find("sched_wakeup: ") != std::string_view::npos ||
+           text.find("sched_wakeup_new: ") != std::string_view::npos;
+}
+
+} // namespace cpu_scheduler
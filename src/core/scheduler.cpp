@@ -1,4 +1,11 @@
 #include "core/scheduler.hpp"
+#include "algorithms/round_robin.hpp"
+#include "algorithms/fcfs.hpp"
+#include "algorithms/sjf.hpp"
+#include "algorithms/priority.hpp"
+#include "algorithms/work_stealing.hpp"
+#include "algorithms/cfs.hpp"
+#include "algorithms/mlfq.hpp"
 
 namespace cpu_scheduler {
 
@@ -6,4 +13,35 @@ namespace cpu_scheduler {
 // This file exists to satisfy the CMake build requirements
 // and for potential future implementations of common scheduler functionality
 
-} // namespace cpu_scheduler 
\ No newline at end of file
+std::unique_ptr<Scheduler> make_scheduler(const std::string& algorithm,
+                                          const SchedulerOptions& options) {
+    if (algorithm == "rr") {
+        return std::make_unique<RoundRobinScheduler>(options.quantum);
+    } else if (algorithm == "fcfs") {
+        return std::make_unique<FCFSScheduler>();
+    } else if (algorithm == "sjf") {
+        return std::make_unique<SJFScheduler>();
+    } else if (algorithm == "srtf") {
+        return std::make_unique<SJFScheduler>(true);
+    } else if (algorithm == "prio") {
+        return std::make_unique<PriorityScheduler>(options.preemptive, options.aging_interval);
+    } else if (algorithm == "ws") {
+        return std::make_unique<WorkStealingScheduler>(options.quantum);
+    } else if (algorithm == "cfs") {
+        return std::make_unique<CFSScheduler>(options.target_latency, options.min_granularity);
+    } else if (algorithm == "mlfq") {
+        return std::make_unique<MLFQScheduler>(options.levels, options.quantum,
+                                               options.boost_interval);
+    }
+    return nullptr;
+}
+
+std::unique_ptr<Scheduler> make_scheduler(const std::string& algorithm, int quantum,
+                                          bool preemptive) {
+    SchedulerOptions options;
+    options.quantum = quantum;
+    options.preemptive = preemptive;
+    return make_scheduler(algorithm, options);
+}
+
+} // namespace cpu_scheduler
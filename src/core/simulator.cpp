@@ -1,78 +1,321 @@
 #include "core/simulator.hpp"
 #include <algorithm>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
 
 namespace cpu_scheduler {
 
 void Simulator::add_process(int arrival_time, int burst_time, int priority) {
-    processes_.push_back(std::make_shared<Process>(
-        next_pid_++, arrival_time, burst_time, priority
-    ));
+    processes_.add(next_pid_++, arrival_time, burst_time, priority);
+}
+
+void Simulator::add_processes(const Workload& workload) {
+    add_processes(workload.data(), workload.size());
+}
+
+void Simulator::add_processes(const WorkloadEntry* entries, size_t count) {
+    processes_.reserve(processes_.size() + count);
+    for (size_t i = 0; i < count; i++) {
+        add_process(entries[i].arrival_time, entries[i].burst_time, entries[i].priority);
+    }
+}
+
+void Simulator::set_process_source(std::unique_ptr<ProcessSource> source) {
+    source_ = std::move(source);
+}
+
+void Simulator::set_event_recorder(EventRecorder* recorder) {
+    if (recorder && cpu_count() > kMaxEventTraceCpus) {
+        throw std::invalid_argument("event traces hold at most " +
+                                    std::to_string(kMaxEventTraceCpus) + " CPUs");
+    }
+    recorder_ = recorder;
 }
 
 SimulationStats Simulator::run() {
-    SimulationStats stats;
-    int current_time = 0;
-    std::shared_ptr<Process> current_process = nullptr;
+    stats_ = SimulationStats{};
+    turnaround_total_ = 0;
+    waiting_total_ = 0;
+    response_total_ = 0;
+    current_time_ = 0;
+    for (auto& cpu : cpus_) {
+        cpu = Cpu{};
+    }
+
+    // Admit processes through a cursor over the arrival order; the stable sort keeps
+    // same-time arrivals in pid order, as the old full scan did
+    processes_.sort_by_arrival();
+    scheduler_->attach(processes_);
+    scheduler_->set_cpu_count(cpu_count());
+    preloaded_processes_ = processes_.size();
+    next_arrival_ = 0;
+    next_streamed_.reset();
+    pull_from_source();
+    const auto& remaining = processes_.remaining_times();
+    incomplete_processes_ = std::count_if(remaining.begin(), remaining.end(),
+        [](int r) { return r > 0; });
 
     while (!is_simulation_complete()) {
-        // Add newly arrived processes
-        add_arrived_processes(current_time);
-
-        // Check if we need to preempt current process
-        if (current_process && scheduler_->needs_preemption(current_process, current_time)) {
-            scheduler_->preempt_process(current_process);
-            current_process = nullptr;
-            stats.total_context_switches++;
-            current_time += context_switch_overhead_;
+        bool idle = step();
+
+        if (mode_ == SimulationMode::EVENT_DRIVEN) {
+            if (idle) {
+                // Nothing is ready, so nothing changes until the next arrival
+                int next_arrival = next_arrival_time();
+                if (next_arrival != std::numeric_limits<int>::max()) {
+                    current_time_ = std::max(current_time_, next_arrival);
+                }
+            } else {
+                skip_quiet_ticks();
+            }
         }
+    }
 
-        // Get next process if none running
-        if (!current_process) {
-            auto next = scheduler_->get_next_process();
-            if (next) {
-                current_process = *next;
-                stats.total_context_switches++;
-                current_time += context_switch_overhead_;
+    if (recorder_) {
+        recorder_->flush();
+    }
+    summarize();
+    return std::move(stats_);
+}
+
+void Simulator::retire(ProcessHandle handle) {
+    // Fold the finished process into the statistics, after which its row is free for the
+    // next arrival
+    ProcessRef done = processes_[handle];
+    int turnaround = done.completion_time() - done.arrival_time();
+    int waiting = turnaround - done.burst_time();
+    int response = done.first_run_time() - done.arrival_time();
+    stats_.completed_processes++;
+    turnaround_total_ += turnaround;
+    waiting_total_ += waiting;
+    response_total_ += response;
+    stats_.turnaround_times.record(turnaround);
+    stats_.waiting_times.record(waiting);
+    stats_.response_times.record(response);
+    processes_.release(handle);
+}
+
+void Simulator::summarize() {
+    SimulationStats& stats = stats_;
+    if (stats.completed_processes > 0) {
+        const double completed = stats.completed_processes;
+        stats.avg_turnaround_time = turnaround_total_ / completed;
+        stats.avg_waiting_time = waiting_total_ / completed;
+        stats.avg_response_time = response_total_ / completed;
+    }
+
+    stats.makespan = current_time_;
+    stats.steals = scheduler_->steals();
+    for (const auto& cpu : cpus_) {
+        stats.total_context_switches += cpu.context_switches;
+        stats.migrations += cpu.migrations;
+        stats.cpu_context_switches.push_back(cpu.context_switches);
+        stats.cpu_utilization.push_back(
+            current_time_ > 0 ? static_cast<double>(cpu.busy_time) / current_time_ : 0.0);
+    }
+}
+
+bool Simulator::step() {
+    // Add newly arrived processes
+    add_arrived_processes(current_time_);
+
+    bool idle = true;
+    for (int index = 0; index < cpu_count(); index++) {
+        Cpu& cpu = cpus_[index];
+        cpu.freed = false;
+        if (cpu.switching) {
+            if (cpu.resume_time > current_time_) {
+                idle = false;
+                continue;
+            }
+            cpu.switching = false;
+            if (!cpu.running) {
+                // Preempted with nothing to switch to
+                cpu.freed = true;
+                idle = false;
+                continue;
+            }
+        } else {
+            int overhead = 0;
+
+            // Check if we need to preempt this CPU's process
+            if (cpu.running && scheduler_->needs_preemption(*cpu.running, current_time_)) {
+                scheduler_->preempt_process_on(*cpu.running, index);
+                if (recorder_) {
+                    recorder_->record(current_time_, processes_[*cpu.running].pid(), index,
+                                      TraceEventKind::PREEMPT);
+                }
+                cpu.running.reset();
+                cpu.context_switches++;
+                overhead += context_switch_overhead_;
+            }
+
+            // Get next process if none running
+            if (!cpu.running) {
+                auto next = scheduler_->get_next_process_on(index);
+                if (next) {
+                    cpu.running = next;
+                    cpu.context_switches++;
+                    overhead += context_switch_overhead_;
+                    ProcessRef dispatched = processes_[*next];
+                    if (dispatched.first_run_time() < 0) {
+                        dispatched.set_first_run_time(current_time_ + overhead);
+                    } else if (dispatched.last_cpu() != index) {
+                        cpu.migrations++;
+                    }
+                    dispatched.set_last_cpu(index);
+                    if (recorder_) {
+                        recorder_->record(current_time_ + overhead, dispatched.pid(), index,
+                                          TraceEventKind::START);
+                    }
+                }
             }
+
+            // The switch stalls this CPU; its process starts once the switch is over
+            if (overhead > 0) {
+                cpu.switching = true;
+                cpu.resume_time = current_time_ + overhead;
+                idle = false;
+                continue;
+            }
+        }
+
+        if (!cpu.running) {
+            continue;
         }
 
-        // Execute current process
-        if (current_process) {
-            current_process->decrement_remaining_time();
-            if (current_process->remaining_time() == 0) {
-                stats.completed_processes++;
-                int turnaround = current_time - current_process->arrival_time();
-                int waiting = turnaround - current_process->burst_time();
-                stats.avg_turnaround_time += turnaround;
-                stats.avg_waiting_time += waiting;
-                current_process = nullptr;
+        // Execute this CPU's process for one time unit
+        idle = false;
+        cpu.busy_time++;
+        ProcessRef running = processes_[*cpu.running];
+        running.decrement_remaining_time();
+        if (running.remaining_time() == 0) {
+            if (running.burst_time() > 0) {
+                incomplete_processes_--;
+            }
+            running.set_completion_time(current_time_ + 1);
+            running.set_state(Process::ProcessState::TERMINATED);
+            if (recorder_) {
+                recorder_->record(current_time_ + 1, running.pid(), index,
+                                  TraceEventKind::COMPLETE);
             }
+            retire(*cpu.running);
+            cpu.running.reset();
+            cpu.freed = true;
         }
+    }
+
+    current_time_++;
+    return idle;
+}
 
-        current_time++;
+void Simulator::skip_quiet_ticks() {
+    // A tick is quiet when nothing arrives, no CPU finishes a context switch, and every
+    // running process neither finishes nor gets preempted, so the only work is
+    // decrementing remaining times.
+    long long quiet = static_cast<long long>(next_arrival_time()) - current_time_;
+    for (const auto& cpu : cpus_) {
+        if (cpu.switching) {
+            quiet = std::min<long long>(quiet, cpu.resume_time - current_time_);
+        } else if (cpu.running) {
+            quiet = std::min<long long>(quiet, processes_[*cpu.running].remaining_time() - 1);
+            quiet = std::min<long long>(
+                quiet, scheduler_->ticks_until_preemption(*cpu.running, current_time_));
+        } else if (cpu.freed) {
+            // A CPU that just became free dispatches on the next tick
+            return;
+        }
+    }
+    if (quiet <= 0) {
+        return;
     }
 
-    // Calculate averages
-    if (stats.completed_processes > 0) {
-        stats.avg_turnaround_time /= stats.completed_processes;
-        stats.avg_waiting_time /= stats.completed_processes;
+    int ticks = static_cast<int>(quiet);
+    for (auto& cpu : cpus_) {
+        if (!cpu.switching && cpu.running) {
+            scheduler_->skip_ticks(*cpu.running, ticks);
+            ProcessRef running = processes_[*cpu.running];
+            running.set_remaining_time(running.remaining_time() - ticks);
+            cpu.busy_time += ticks;
+        }
     }
+    current_time_ += ticks;
+}
+
+int Simulator::current_time() const {
+    return current_time_;
+}
+
+int Simulator::context_switch_overhead() const {
+    return context_switch_overhead_;
+}
 
-    return stats;
+SimulationMode Simulator::mode() const {
+    return mode_;
+}
+
+int Simulator::cpu_count() const {
+    return static_cast<int>(cpus_.size());
+}
+
+size_t Simulator::process_table_size() const {
+    return processes_.size();
 }
 
 bool Simulator::is_simulation_complete() const {
-    return std::all_of(processes_.begin(), processes_.end(),
-        [](const auto& p) { return p->remaining_time() == 0; });
+    return incomplete_processes_ == 0 && !next_streamed_;
 }
 
 void Simulator::add_arrived_processes(int current_time) {
-    for (const auto& process : processes_) {
-        if (process->arrival_time() == current_time) {
-            scheduler_->add_process(process);
+    // Context switch overhead moves the clock by more than one unit, so admit everything
+    // that arrived since the last check rather than only exact matches
+    while (next_arrival_ < preloaded_processes_ &&
+           processes_[next_arrival_].arrival_time() <= current_time) {
+        record_arrival(static_cast<ProcessHandle>(next_arrival_));
+        scheduler_->add_process(static_cast<ProcessHandle>(next_arrival_++));
+    }
+
+    while (next_streamed_ && next_streamed_->arrival_time <= current_time) {
+        ProcessHandle handle = processes_.add(next_pid_++, next_streamed_->arrival_time,
+                                              next_streamed_->burst_time,
+                                              next_streamed_->priority);
+        if (next_streamed_->burst_time > 0) {
+            incomplete_processes_++;
         }
+        record_arrival(handle);
+        scheduler_->add_process(handle);
+        pull_from_source();
+    }
+}
+
+void Simulator::record_arrival(ProcessHandle handle) {
+    if (recorder_) {
+        ProcessRef arrived = processes_[handle];
+        recorder_->record(arrived.arrival_time(), arrived.pid(), -1, TraceEventKind::ARRIVE);
+    }
+}
+
+void Simulator::pull_from_source() {
+    WorkloadEntry entry;
+    if (!source_ || !source_->next(entry)) {
+        next_streamed_.reset();
+        return;
+    }
+    if (next_streamed_ && entry.arrival_time < next_streamed_->arrival_time) {
+        throw std::runtime_error("process source is not sorted by arrival time");
+    }
+    next_streamed_ = entry;
+}
+
+int Simulator::next_arrival_time() const {
+    int next = next_arrival_ < preloaded_processes_ ? processes_[next_arrival_].arrival_time()
+                                                    : std::numeric_limits<int>::max();
+    if (next_streamed_) {
+        next = std::min(next, next_streamed_->arrival_time);
     }
+    return next;
 }
 
-} // namespace cpu_scheduler 
\ No newline at end of file
+} // namespace cpu_scheduler
@@ -0,0 +1,134 @@
+#include "core/sweep.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace cpu_scheduler {
+
+namespace {
+
+// Algorithms whose results depend on the time quantum
+bool uses_quantum(const std::string& algorithm) {
+    return algorithm == "rr" || algorithm == "ws" || algorithm == "mlfq";
+}
+
+} // namespace
+
+std::vector<SweepPoint> make_sweep_grid(const std::vector<std::string>& algorithms,
+                                        const std::vector<int>& quanta,
+                                        const std::vector<int>& overheads,
+                                        bool preemptive,
+                                        const std::vector<int>& cpu_counts) {
+    std::vector<SweepPoint> grid;
+    for (const auto& algorithm : algorithms) {
+        for (int overhead : overheads) {
+            for (int cpus : cpu_counts) {
+                if (uses_quantum(algorithm)) {
+                    for (int quantum : quanta) {
+                        grid.push_back({algorithm, quantum, overhead, preemptive, cpus});
+                    }
+                } else {
+                    grid.push_back({algorithm, 0, overhead, preemptive, cpus});
+                }
+            }
+        }
+    }
+    return grid;
+}
+
+std::vector<SweepResult> run_sweep(const Workload& workload, const std::vector<SweepPoint>& grid,
+                                   unsigned threads, const SchedulerOptions& options) {
+    auto options_for = [&options](const SweepPoint& point) {
+        SchedulerOptions point_options = options;
+        point_options.quantum = std::max(point.quantum, 1);
+        point_options.preemptive = point.preemptive;
+        return point_options;
+    };
+
+    // Reject bad names up front rather than from inside a worker
+    for (const auto& point : grid) {
+        if (!make_scheduler(point.algorithm, options_for(point))) {
+            throw std::invalid_argument("Unknown algorithm: " + point.algorithm);
+        }
+    }
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, grid.size()));
+
+    std::vector<SweepResult> results(grid.size());
+    std::atomic<size_t> next_point{0};
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+
+    // Workers pull the next unclaimed point until the grid is exhausted
+    auto worker = [&]() {
+        for (size_t i = next_point++; i < grid.size(); i = next_point++) {
+            try {
+                const SweepPoint& point = grid[i];
+                auto scheduler = make_scheduler(point.algorithm, options_for(point));
+                results[i].point = point;
+                results[i].scheduler_name = scheduler->name();
+
+                Simulator sim(std::move(scheduler), point.context_switch_overhead,
+                              SimulationMode::EVENT_DRIVEN, point.cpus);
+                sim.add_processes(workload);
+                results[i].stats = sim.run();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failure_mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back(worker);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    return results;
+}
+
+std::string format_sweep_table(const std::vector<SweepResult>& results) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2) << std::left
+       << std::setw(8) << "algo" << std::right
+       << std::setw(8) << "quantum" << std::setw(8) << "ctx" << std::setw(6) << "cpus"
+       << std::setw(12) << "avg_wait" << std::setw(10) << "p99_wait" << std::setw(16) << "avg_turnaround"
+       << std::setw(14) << "avg_response" << std::setw(12) << "switches"
+       << std::setw(11) << "completed" << std::setw(10) << "makespan" << "\n";
+
+    for (const auto& result : results) {
+        const auto& stats = result.stats;
+        ss << std::left << std::setw(8) << result.point.algorithm << std::right
+           << std::setw(8)
+           << (uses_quantum(result.point.algorithm) ? std::to_string(result.point.quantum) : "-")
+           << std::setw(8) << result.point.context_switch_overhead
+           << std::setw(6) << result.point.cpus
+           << std::setw(12) << stats.avg_waiting_time
+           << std::setw(10) << stats.waiting_times.percentile(99)
+           << std::setw(16) << stats.avg_turnaround_time
+           << std::setw(14) << stats.avg_response_time
+           << std::setw(12) << stats.total_context_switches
+           << std::setw(11) << stats.completed_processes
+           << std::setw(10) << stats.makespan << "\n";
+    }
+    return ss.str();
+}
+
+} // namespace cpu_scheduler
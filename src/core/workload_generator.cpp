@@ -0,0 +1,131 @@
+#include "core/workload_generator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace cpu_scheduler {
+
+WorkloadGenerator::WorkloadGenerator(const GeneratorOptions& options)
+    : options_(options), rng_(options.seed) {
+    if (!(options_.arrival_rate > 0) || !(options_.mean_burst > 0) ||
+        !(options_.mean_clump_size >= 1)) {
+        throw std::invalid_argument("arrival rate, mean burst and clump size must be positive");
+    }
+    if (options_.bursts == BurstModel::PARETO && !(options_.pareto_shape > 1)) {
+        throw std::invalid_argument("a Pareto shape of 1 or less has no mean");
+    }
+    if (options_.bursts == BurstModel::BIMODAL &&
+        (options_.long_burst_fraction < 0 || options_.long_burst_fraction > 1 ||
+         !(options_.long_burst_ratio > 0))) {
+        throw std::invalid_argument("bimodal bursts need a long fraction in [0, 1] and a "
+                                    "positive ratio");
+    }
+    if (options_.priority_mix.empty()) {
+        throw std::invalid_argument("the priority mix is empty");
+    }
+
+    double total = 0;
+    for (const auto& [priority, weight] : options_.priority_mix) {
+        if (!(weight > 0)) {
+            throw std::invalid_argument("priority weights must be positive");
+        }
+        total += weight;
+        cumulative_weights_.push_back(total);
+    }
+    for (double& weight : cumulative_weights_) {
+        weight /= total;
+    }
+}
+
+bool WorkloadGenerator::next(WorkloadEntry& entry) {
+    if (generated_ == options_.count) {
+        return false;
+    }
+
+    if (clump_left_ == 0) {
+        clump_left_ = 1;
+        double group_rate = options_.arrival_rate;
+        if (options_.arrivals == ArrivalModel::BURSTY) {
+            // Geometric clump size with the requested mean, and clumps spaced so the
+            // overall rate is unchanged
+            double stop = 1.0 / options_.mean_clump_size;
+            if (stop < 1) {
+                clump_left_ += static_cast<uint64_t>(std::log(uniform()) / std::log1p(-stop));
+            }
+            group_rate /= options_.mean_clump_size;
+        }
+        // The first process arrives at 0 so the run does not start with idle time
+        if (generated_ > 0) {
+            clock_ += exponential(1.0 / group_rate);
+        }
+        if (clock_ > std::numeric_limits<int>::max()) {
+            throw std::runtime_error("generated arrivals outgrow the simulator clock; "
+                                     "raise the arrival rate");
+        }
+    }
+    clump_left_--;
+
+    entry.arrival_time = static_cast<int>(clock_);
+    entry.burst_time = draw_burst();
+    entry.priority = draw_priority();
+    generated_++;
+    return true;
+}
+
+double WorkloadGenerator::uniform() {
+    // 53 random bits, shifted off zero so logarithms stay finite
+    return (static_cast<double>(rng_() >> 11) + 1.0) * 0x1.0p-53;
+}
+
+double WorkloadGenerator::exponential(double mean) {
+    return -mean * std::log(uniform());
+}
+
+int WorkloadGenerator::draw_burst() {
+    double burst = 0;
+    switch (options_.bursts) {
+    case BurstModel::EXPONENTIAL:
+        burst = exponential(options_.mean_burst);
+        break;
+    case BurstModel::PARETO: {
+        double shape = options_.pareto_shape;
+        double scale = options_.mean_burst * (shape - 1) / shape;
+        burst = scale / std::pow(uniform(), 1.0 / shape);
+        break;
+    }
+    case BurstModel::BIMODAL: {
+        // Short and long means chosen so the mixture has the requested mean
+        double fraction = options_.long_burst_fraction;
+        double short_mean =
+            options_.mean_burst / (1 - fraction + fraction * options_.long_burst_ratio);
+        bool is_long = uniform() <= fraction;
+        burst = exponential(is_long ? short_mean * options_.long_burst_ratio : short_mean);
+        break;
+    }
+    }
+    return static_cast<int>(std::clamp(std::round(burst), 1.0,
+                                       static_cast<double>(std::numeric_limits<int>::max())));
+}
+
+int WorkloadGenerator::draw_priority() {
+    if (cumulative_weights_.size() == 1) {
+        return options_.priority_mix.front().first;
+    }
+    double u = uniform();
+    size_t index = std::lower_bound(cumulative_weights_.begin(), cumulative_weights_.end(), u) -
+                   cumulative_weights_.begin();
+    return options_.priority_mix[std::min(index, cumulative_weights_.size() - 1)].first;
+}
+
+Workload generate_workload(const GeneratorOptions& options) {
+    WorkloadGenerator generator(options);
+    Workload workload;
+    workload.reserve(static_cast<size_t>(options.count));
+    for (WorkloadEntry entry; generator.next(entry);) {
+        workload.push_back(entry);
+    }
+    return workload;
+}
+
+} // namespace cpu_scheduler
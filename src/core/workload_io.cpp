@@ -0,0 +1,192 @@
+#include "core/workload_io.hpp"
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+namespace cpu_scheduler {
+
+namespace {
+
+using json = nlohmann::json;
+
+/**
+ * @brief SAX handler that picks process objects out of the "processes" array
+ *
+ * Everything else in the document (descriptions, metadata, other scenarios) is skipped
+ * without being stored.
+ */
+class WorkloadSax : public nlohmann::json_sax<json> {
+public:
+    WorkloadSax(const std::function<void(const WorkloadEntry&)>& emit, const std::string& scenario)
+        : emit_(emit), scenario_(scenario), key_depth_(scenario.empty() ? 1 : 2),
+          in_scenario_(scenario.empty()) {}
+
+    bool found_scenario() const { return found_scenario_; }
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t value) override { return field(value); }
+    bool number_unsigned(number_unsigned_t value) override { return field(value); }
+    bool number_float(number_float_t value, const string_t&) override { return field(value); }
+    bool string(string_t&) override { return true; }
+    bool binary(binary_t&) override { return true; }
+
+    bool start_object(std::size_t) override {
+        depth_++;
+        if (in_process()) {
+            entry_ = WorkloadEntry{0, 0, 0};
+            fields_ = 0;
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        if (in_process()) {
+            if (fields_ != (kArrival | kBurst | kPriority)) {
+                throw std::runtime_error("process " + std::to_string(count_ + 1) +
+                                         " needs arrival_time, burst_time and priority");
+            }
+            emit_(entry_);
+            count_++;
+        }
+        depth_--;
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        depth_++;
+        if (depth_ == key_depth_ + 1 && processes_key_) {
+            processes_depth_ = depth_;
+        }
+        return true;
+    }
+
+    bool end_array() override {
+        if (depth_ == processes_depth_) {
+            processes_depth_ = -1;
+        }
+        depth_--;
+        return true;
+    }
+
+    bool key(string_t& name) override {
+        if (!scenario_.empty() && depth_ == 1) {
+            in_scenario_ = name == scenario_;
+            found_scenario_ = found_scenario_ || in_scenario_;
+            processes_key_ = false;
+        } else if (depth_ == key_depth_) {
+            processes_key_ = in_scenario_ && name == "processes";
+        } else if (in_process()) {
+            field_ = name == "arrival_time" ? kArrival
+                   : name == "burst_time"   ? kBurst
+                   : name == "priority"     ? kPriority
+                                            : 0;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override {
+        throw std::runtime_error(e.what());
+    }
+
+private:
+    enum Field { kArrival = 1, kBurst = 2, kPriority = 4 };
+
+    // True while directly inside one element of the processes array
+    bool in_process() const { return processes_depth_ > 0 && depth_ == processes_depth_ + 1; }
+
+    template <typename Number>
+    bool field(Number value) {
+        if (!in_process() || field_ == 0) {
+            return true;
+        }
+        int v = static_cast<int>(value);
+        if (field_ == kArrival) entry_.arrival_time = v;
+        if (field_ == kBurst) entry_.burst_time = v;
+        if (field_ == kPriority) entry_.priority = v;
+        fields_ |= field_;
+        field_ = 0;
+        return true;
+    }
+
+    const std::function<void(const WorkloadEntry&)>& emit_;
+    const std::string& scenario_;
+    // Depth of the object holding the "processes" key: the root, or the scenario object
+    const int key_depth_;
+    bool in_scenario_;
+    bool found_scenario_{false};
+    int depth_{0};
+    int processes_depth_{-1};
+    bool processes_key_{false};
+    int field_{0};
+    int fields_{0};
+    long long count_{0};
+    WorkloadEntry entry_{0, 0, 0};
+};
+
+} // namespace
+
+void read_workload(std::istream& in, const std::function<void(const WorkloadEntry&)>& emit,
+                   const std::string& scenario) {
+    WorkloadSax handler(emit, scenario);
+    json::sax_parse(in, &handler);
+    if (!scenario.empty() && !handler.found_scenario()) {
+        throw std::runtime_error("no scenario named " + scenario);
+    }
+}
+
+Workload load_workload(const std::string& filename, const std::string& scenario) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("cannot open " + filename);
+    }
+    Workload workload;
+    read_workload(file, [&workload](const WorkloadEntry& entry) { workload.push_back(entry); },
+                  scenario);
+    return workload;
+}
+
+bool JsonLinesSource::next(WorkloadEntry& entry) {
+    while (std::getline(*in_, line_)) {
+        line_number_++;
+        if (line_.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        json p = json::parse(line_, nullptr, false);
+        if (p.is_discarded() || !p.is_object() || !p.contains("arrival_time") ||
+            !p.contains("burst_time") || !p.contains("priority")) {
+            throw std::runtime_error("line " + std::to_string(line_number_) +
+                                     ": expected a process object");
+        }
+        entry.arrival_time = p["arrival_time"].get<int>();
+        entry.burst_time = p["burst_time"].get<int>();
+        entry.priority = p["priority"].get<int>();
+
+        if (entry.arrival_time < last_arrival_) {
+            throw std::runtime_error("line " + std::to_string(line_number_) +
+                                     ": arrivals must be sorted when streaming");
+        }
+        last_arrival_ = entry.arrival_time;
+        return true;
+    }
+    return false;
+}
+
+std::unique_ptr<ProcessSource> open_workload_stream(const std::string& filename) {
+    auto file = std::make_unique<std::ifstream>(filename);
+    if (!*file) {
+        throw std::runtime_error("cannot open " + filename);
+    }
+    return std::make_unique<JsonLinesSource>(std::move(file));
+}
+
+bool is_streaming_workload(const std::string& filename) {
+    auto ends_with = [&filename](const std::string& suffix) {
+        return filename.size() >= suffix.size() &&
+               filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    return ends_with(".jsonl") || ends_with(".ndjson");
+}
+
+} // namespace cpu_scheduler
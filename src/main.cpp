@@ -1,115 +1,378 @@
+#include "core/binary_trace.hpp"
+#include "core/chrome_trace.hpp"
+#include "core/ftrace_import.hpp"
 #include "core/simulator.hpp"
-#include "algorithms/round_robin.hpp"
-#include "algorithms/fcfs.hpp"
-#include "algorithms/sjf.hpp"
-#include "algorithms/priority.hpp"
+#include "core/sweep.hpp"
+#include "core/workload_generator.hpp"
+#include "core/workload_io.hpp"
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <nlohmann/json.hpp>
 #include <CLI/CLI.hpp>
 
-using json = nlohmann::json;
 using namespace cpu_scheduler;
 
 struct Config {
     std::string algo = "rr";
     int quantum = 4;
     int ctx_switch = 0;
+    int target_latency = 6;
+    int min_granularity = 1;
+    int levels = 3;
+    int boost_interval = 100;
+    int aging_interval = 0;
+    int cpus = 1;
+    int trace_unit_us = 1;
+    long long trace_split_us = FtraceSource::kDefaultSplitAfterUs;
     std::string workload;
+    std::string scenario;
+    std::string convert;
+    std::string trace;
+    std::string chrome_trace;
+    std::string trace_tracks = "cpu";
+    uint64_t generate = 0;
+    uint64_t seed = 1;
+    std::string arrivals = "poisson";
+    double arrival_rate = 0.1;
+    double clump_size = 8.0;
+    std::string bursts = "exp";
+    double mean_burst = 8.0;
+    double pareto_shape = 1.5;
+    std::vector<int> priorities = {0};
     bool verbose = false;
     bool preempt = true;
+    bool tick = false;
+    bool sweep = false;
+    std::vector<std::string> sweep_algos = {"rr", "fcfs", "sjf", "prio"};
+    std::vector<int> sweep_quanta = {1, 2, 4, 8};
+    std::vector<int> sweep_overheads = {0, 1};
+    std::vector<int> sweep_cpus = {1};
+    unsigned jobs = 0;
 };
 
-std::vector<std::tuple<int, int, int>> load_workload(const std::string& filename) {
-    std::vector<std::tuple<int, int, int>> workload;
-    std::ifstream file(filename);
-    json j;
-    file >> j;
+const Workload kDefaultWorkload = {
+    {0, 5, 1},
+    {2, 3, 2},
+    {4, 4, 1},
+    {6, 2, 3}
+};
+
+GeneratorOptions generator_options(const Config& cfg) {
+    GeneratorOptions options;
+    options.count = cfg.generate;
+    options.seed = cfg.seed;
+    if (cfg.arrivals == "poisson") {
+        options.arrivals = ArrivalModel::POISSON;
+    } else if (cfg.arrivals == "bursty") {
+        options.arrivals = ArrivalModel::BURSTY;
+    } else {
+        throw std::invalid_argument("unknown arrival model " + cfg.arrivals);
+    }
+    options.arrival_rate = cfg.arrival_rate;
+    options.mean_clump_size = cfg.clump_size;
+    if (cfg.bursts == "exp") {
+        options.bursts = BurstModel::EXPONENTIAL;
+    } else if (cfg.bursts == "pareto") {
+        options.bursts = BurstModel::PARETO;
+    } else if (cfg.bursts == "bimodal") {
+        options.bursts = BurstModel::BIMODAL;
+    } else {
+        throw std::invalid_argument("unknown burst model " + cfg.bursts);
+    }
+    options.mean_burst = cfg.mean_burst;
+    options.pareto_shape = cfg.pareto_shape;
+    options.priority_mix.clear();
+    for (int priority : cfg.priorities) {
+        options.priority_mix.emplace_back(priority, 1.0);
+    }
+    return options;
+}
 
-    for (const auto& p : j["processes"]) {
-        workload.emplace_back(
-            p["arrival_time"].get<int>(),
-            p["burst_time"].get<int>(),
-            p["priority"].get<int>()
-        );
+// Whole-workload load for modes that replay it more than once
+Workload load_all(const Config& cfg) {
+    const std::string& filename = cfg.workload;
+    if (cfg.generate > 0) {
+        return generate_workload(generator_options(cfg));
+    }
+    if (filename.empty()) {
+        return kDefaultWorkload;
+    }
+    if (is_binary_trace(filename)) {
+        MappedTrace trace(filename);
+        return Workload(trace.records(), trace.records() + trace.size());
+    }
+    std::unique_ptr<ProcessSource> source;
+    if (is_ftrace(filename)) {
+        source =
+            std::make_unique<FtraceSource>(filename, cfg.trace_unit_us, cfg.trace_split_us);
+    } else if (is_streaming_workload(filename)) {
+        source = open_workload_stream(filename);
+    } else {
+        return load_workload(filename, cfg.scenario);
+    }
+    Workload workload;
+    for (WorkloadEntry entry; source->next(entry);) {
+        workload.push_back(entry);
     }
     return workload;
 }
 
+// Single runs feed the simulator directly: generated workloads, binary traces, kernel traces
+// and .jsonl are pulled lazily during the run, JSON documents are parsed event by event
+// straight into the process table
+void feed_simulator(Simulator& sim, const Config& cfg) {
+    const std::string& filename = cfg.workload;
+    if (cfg.generate > 0) {
+        sim.set_process_source(std::make_unique<WorkloadGenerator>(generator_options(cfg)));
+    } else if (filename.empty()) {
+        sim.add_processes(kDefaultWorkload);
+    } else if (is_binary_trace(filename)) {
+        sim.set_process_source(std::make_unique<BinaryTraceSource>(filename));
+    } else if (is_ftrace(filename)) {
+        sim.set_process_source(
+            std::make_unique<FtraceSource>(filename, cfg.trace_unit_us, cfg.trace_split_us));
+    } else if (is_streaming_workload(filename)) {
+        sim.set_process_source(open_workload_stream(filename));
+    } else {
+        std::ifstream file(filename);
+        if (!file) {
+            throw std::runtime_error("cannot open " + filename);
+        }
+        read_workload(file, [&sim](const WorkloadEntry& entry) {
+            sim.add_process(entry.arrival_time, entry.burst_time, entry.priority);
+        }, cfg.scenario);
+    }
+}
+
 void print_help() {
     std::cout << "Available Scheduling Algorithms:\n"
               << "  rr    - Round Robin\n"
               << "  fcfs  - First Come First Serve\n"
               << "  sjf   - Shortest Job First\n"
-              << "  prio  - Priority Scheduling\n\n"
+              << "  srtf  - Shortest Remaining Time First (preemptive SJF)\n"
+              << "  prio  - Priority Scheduling\n"
+              << "  ws    - Work Stealing (one run queue per CPU, use with --cpus)\n"
+              << "  cfs   - Completely Fair Scheduler (priority is the nice value)\n"
+              << "  mlfq  - Multilevel Feedback Queue (-q is the top-level quantum)\n\n"
               << "Example Usage:\n"
               << "  ./cpu-scheduler -a rr -q 4\n"
               << "  ./cpu-scheduler -a prio --preemptive\n"
-              << "  ./cpu-scheduler -a sjf -w workload.json\n";
+              << "  ./cpu-scheduler -a prio --aging 10 -w workload.json\n"
+              << "  ./cpu-scheduler -a rr -q 4 --cpus 16 -w workload.json\n"
+              << "  ./cpu-scheduler -a ws -q 4 --cpus 16 -w workload.json\n"
+              << "  ./cpu-scheduler -a sjf -w workload.json\n"
+              << "  ./cpu-scheduler -a cfs --latency 24 --min-granularity 3 -w workload.json\n"
+              << "  ./cpu-scheduler -a mlfq -q 2 --levels 4 --boost 50 -w workload.json\n"
+              << "  ./cpu-scheduler -a rr -w trace.jsonl      (streamed, one process per line)\n"
+              << "  ./cpu-scheduler -a cfs -n 8 --generate 1000000 --rate 0.9 --bursts pareto\n"
+              << "  ./cpu-scheduler -a rr -w scenarios.json --scenario heavy_load\n"
+              << "  ./cpu-scheduler -w workload.json --convert trace.bin\n"
+              << "  ./cpu-scheduler -a rr -w trace.bin        (memory-mapped binary trace)\n"
+              << "  ./cpu-scheduler -a cfs -n 4 -w workloads/sched_switch.txt --trace-unit 100\n"
+              << "                                            (ftrace or perf sched script dump)\n"
+              << "  ./cpu-scheduler -a rr -w workload.json --trace events.bin\n"
+              << "  ./cpu-scheduler -a rr -n 4 -w workload.json --chrome-trace run.json\n"
+              << "  ./cpu-scheduler --sweep --algos rr,sjf --quanta 2,4,8 --overheads 0,1 -w workload.json\n"
+              << "  ./cpu-scheduler --sweep --algos rr --cpu-counts 1,2,4,8,16,32,64,128 -w workload.json\n";
 }
 
 int main(int argc, char** argv) {
     Config cfg;
     CLI::App app{"CPU Scheduler"};
 
-    app.add_option("-a,--algo", cfg.algo, "algorithm (rr/fcfs/sjf/prio)")
+    app.add_option("-a,--algo", cfg.algo, "algorithm (rr/fcfs/sjf/srtf/prio/ws/cfs/mlfq)")
         ->default_str("rr");
-    app.add_option("-q", cfg.quantum, "quantum for RR")
+    app.add_option("-q", cfg.quantum, "quantum for RR and WS, top-level quantum for MLFQ")
         ->default_val(4);
     app.add_option("-c", cfg.ctx_switch, "context switch overhead")
         ->default_val(0);
+    app.add_option("--latency", cfg.target_latency, "CFS target latency")
+        ->default_val(6);
+    app.add_option("--min-granularity", cfg.min_granularity, "CFS minimum slice")
+        ->default_val(1);
+    app.add_option("--levels", cfg.levels, "MLFQ priority levels")
+        ->default_val(3);
+    app.add_option("--boost", cfg.boost_interval, "MLFQ boost interval (0 to disable)")
+        ->default_val(100);
+    app.add_option("--aging", cfg.aging_interval,
+                   "priority aging: waiting time per level gained (0 to disable)")
+        ->default_val(0);
+    app.add_option("-n,--cpus", cfg.cpus, "number of CPUs sharing the ready queue")
+        ->default_val(1);
     app.add_option("-w", cfg.workload, "workload file");
+    app.add_option("--generate", cfg.generate, "simulate this many synthetic processes");
+    app.add_option("--seed", cfg.seed, "seed of the synthetic workload")->default_val(1);
+    app.add_option("--arrivals", cfg.arrivals, "synthetic arrivals: poisson or bursty")
+        ->default_str("poisson");
+    app.add_option("--rate", cfg.arrival_rate, "synthetic arrivals per time unit")
+        ->default_val(0.1);
+    app.add_option("--clump", cfg.clump_size, "mean processes per bursty arrival")
+        ->default_val(8.0);
+    app.add_option("--bursts", cfg.bursts, "synthetic burst times: exp, pareto or bimodal")
+        ->default_str("exp");
+    app.add_option("--mean-burst", cfg.mean_burst, "mean synthetic burst time")
+        ->default_val(8.0);
+    app.add_option("--pareto-shape", cfg.pareto_shape, "tail index of Pareto bursts")
+        ->default_val(1.5);
+    app.add_option("--priorities", cfg.priorities, "synthetic priorities, drawn uniformly")
+        ->delimiter(',');
+    app.add_option("--trace-unit", cfg.trace_unit_us,
+                   "microseconds per time unit when replaying a kernel trace")
+        ->default_val(1);
+    app.add_option("--trace-split", cfg.trace_split_us,
+                   "microseconds after which a kernel trace burst is cut, 0 for never")
+        ->default_val(FtraceSource::kDefaultSplitAfterUs);
+    app.add_option("--scenario", cfg.scenario, "scenario to read from a scenarios file");
+    app.add_option("--convert", cfg.convert, "write the workload as a binary trace and exit");
+    app.add_option("--trace", cfg.trace, "write a binary event trace of the run to this file");
+    app.add_option("--chrome-trace", cfg.chrome_trace,
+                   "write the run as Chrome trace-event JSON to this file");
+    app.add_option("--trace-tracks", cfg.trace_tracks, "Chrome trace rows: cpu or pid")
+        ->default_str("cpu");
     app.add_flag("-v", cfg.verbose, "verbose output");
     app.add_flag("-p", cfg.preempt, "preemptive scheduling");
+    app.add_flag("--tick", cfg.tick, "advance one time unit per step (reference mode)");
+    app.add_flag("--sweep", cfg.sweep, "simulate every algorithm x quantum x overhead combination");
+    app.add_option("--algos", cfg.sweep_algos, "algorithms to sweep")->delimiter(',');
+    app.add_option("--quanta", cfg.sweep_quanta, "RR quanta to sweep")->delimiter(',');
+    app.add_option("--overheads", cfg.sweep_overheads, "context switch overheads to sweep")
+        ->delimiter(',');
+    app.add_option("--cpu-counts", cfg.sweep_cpus, "CPU counts to sweep")->delimiter(',');
+    app.add_option("-j,--jobs", cfg.jobs, "sweep worker threads (default: all cores)");
     app.add_flag("-h,--help", [](){ print_help(); exit(0); }, 
                  "Show detailed help");
 
     CLI11_PARSE(app, argc, argv);
 
-    std::unique_ptr<Scheduler> scheduler;
-    if (cfg.algo == "rr") {
-        scheduler = std::make_unique<RoundRobinScheduler>(cfg.quantum);
-    } else if (cfg.algo == "fcfs") {
-        scheduler = std::make_unique<FCFSScheduler>();
-    } else if (cfg.algo == "sjf") {
-        scheduler = std::make_unique<SJFScheduler>();
-    } else if (cfg.algo == "prio") {
-        scheduler = std::make_unique<PriorityScheduler>(cfg.preempt);
-    } else {
-        std::cerr << "Unknown algorithm: " << cfg.algo << std::endl;
-        print_help();
-        return 1;
+    if (!cfg.convert.empty()) {
+        try {
+            Workload workload = load_all(cfg);
+            write_binary_trace(cfg.convert, workload);
+            std::cout << "Wrote " << workload.size() << " processes to " << cfg.convert
+                      << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to convert workload: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
     }
 
-    Simulator sim(std::move(scheduler), cfg.ctx_switch);
+    SchedulerOptions options;
+    options.quantum = cfg.quantum;
+    options.preemptive = cfg.preempt;
+    options.target_latency = cfg.target_latency;
+    options.min_granularity = cfg.min_granularity;
+    options.levels = cfg.levels;
+    options.boost_interval = cfg.boost_interval;
+    options.aging_interval = cfg.aging_interval;
 
-    std::vector<std::tuple<int, int, int>> workload;
-    if (!cfg.workload.empty()) {
+    if (cfg.sweep) {
+        Workload workload;
         try {
-            workload = load_workload(cfg.workload);
+            workload = load_all(cfg);
         } catch (const std::exception& e) {
             std::cerr << "Failed to load workload: " << e.what() << std::endl;
             return 1;
         }
-    } else {
-        workload = {
-            {0, 5, 1},
-            {2, 3, 2},
-            {4, 4, 1},
-            {6, 2, 3}
-        };
+
+        try {
+            auto grid = make_sweep_grid(cfg.sweep_algos, cfg.sweep_quanta, cfg.sweep_overheads,
+                                        cfg.preempt, cfg.sweep_cpus);
+            auto results = run_sweep(workload, grid, cfg.jobs, options);
+            std::cout << "\nSweep Results (" << results.size() << " runs):\n"
+                      << "==================\n"
+                      << format_sweep_table(results);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            print_help();
+            return 1;
+        }
+        return 0;
+    }
+
+    auto scheduler = make_scheduler(cfg.algo, options);
+    if (!scheduler) {
+        std::cerr << "Unknown algorithm: " << cfg.algo << std::endl;
+        print_help();
+        return 1;
+    }
+
+    if (cfg.cpus < 1) {
+        std::cerr << "Need at least one CPU" << std::endl;
+        return 1;
+    }
+    Simulator sim(std::move(scheduler), cfg.ctx_switch,
+                  cfg.tick ? SimulationMode::TICK : SimulationMode::EVENT_DRIVEN, cfg.cpus);
+    try {
+        feed_simulator(sim, cfg);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to load workload: " << e.what() << std::endl;
+        return 1;
     }
 
-    for (const auto& [arrival, burst, prio] : workload) {
-        sim.add_process(arrival, burst, prio);
+    if (cfg.trace_tracks != "cpu" && cfg.trace_tracks != "pid") {
+        std::cerr << "--trace-tracks must be cpu or pid" << std::endl;
+        return 1;
+    }
+    if ((!cfg.trace.empty() || !cfg.chrome_trace.empty()) && cfg.cpus > kMaxEventTraceCpus) {
+        std::cerr << "Traced runs support at most " << kMaxEventTraceCpus << " CPUs"
+                  << std::endl;
+        return 1;
+    }
+
+    // Sinks are declared before the recorder that writes to them, so they outlive it
+    std::unique_ptr<BinaryEventTraceWriter> trace_writer;
+    std::ofstream chrome_file;
+    std::unique_ptr<ChromeTraceWriter> chrome_writer;
+    std::unique_ptr<TeeTraceSink> tee;
+    std::unique_ptr<EventRecorder> recorder;
+    try {
+        if (!cfg.trace.empty()) {
+            trace_writer = std::make_unique<BinaryEventTraceWriter>(cfg.trace);
+        }
+        if (!cfg.chrome_trace.empty()) {
+            chrome_file.open(cfg.chrome_trace);
+            if (!chrome_file) {
+                throw std::runtime_error("cannot write " + cfg.chrome_trace);
+            }
+            chrome_writer = std::make_unique<ChromeTraceWriter>(
+                chrome_file,
+                cfg.trace_tracks == "pid" ? ChromeTraceTracks::PROCESS : ChromeTraceTracks::CPU);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to open trace: " << e.what() << std::endl;
+        return 1;
+    }
+    TraceSink* sink = trace_writer ? static_cast<TraceSink*>(trace_writer.get())
+                                   : chrome_writer.get();
+    if (trace_writer && chrome_writer) {
+        tee = std::make_unique<TeeTraceSink>(*trace_writer, *chrome_writer);
+        sink = tee.get();
+    }
+    if (sink) {
+        recorder = std::make_unique<EventRecorder>(*sink);
+        sim.set_event_recorder(recorder.get());
     }
 
-    auto stats = sim.run();
+    SimulationStats stats;
+    try {
+        stats = sim.run();
+    } catch (const std::exception& e) {
+        std::cerr << "Simulation failed: " << e.what() << std::endl;
+        return 1;
+    }
 
     std::cout << "\nSimulation Results:\n"
               << "==================\n"
               << stats.to_string() << std::endl;
+    if (trace_writer) {
+        std::cout << "Wrote " << recorder->recorded() << " events to " << cfg.trace
+                  << std::endl;
+    }
+    if (chrome_writer) {
+        chrome_writer->finish();
+        std::cout << "Wrote Chrome trace to " << cfg.chrome_trace << std::endl;
+    }
 
     return 0;
 } 
\ No newline at end of file
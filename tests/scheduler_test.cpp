@@ -4,6 +4,25 @@
 #include "algorithms/fcfs.hpp"
 #include "algorithms/sjf.hpp"
 #include "algorithms/priority.hpp"
+#include "algorithms/work_stealing.hpp"
+#include "algorithms/cfs.hpp"
+#include "algorithms/mlfq.hpp"
+#include "core/binary_trace.hpp"
+#include "core/chrome_trace.hpp"
+#include "core/event_trace.hpp"
+#include "core/ftrace_import.hpp"
+#include "core/sweep.hpp"
+#include "core/workload_generator.hpp"
+#include "core/workload_io.hpp"
+#include <nlohmann/json.hpp>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
 
 using namespace cpu_scheduler;
 
@@ -112,6 +131,912 @@ TEST_F(SchedulerTest, SameArrival) {
     EXPECT_EQ(stats.completed_processes, 3);
 }
 
+TEST_F(SchedulerTest, EventDrivenMatchesTick) {
+    std::vector<std::function<std::unique_ptr<Scheduler>()>> factories = {
+        [] { return std::make_unique<RoundRobinScheduler>(1); },
+        [] { return std::make_unique<RoundRobinScheduler>(3); },
+        [] { return std::make_unique<FCFSScheduler>(); },
+        [] { return std::make_unique<SJFScheduler>(); },
+        [] { return std::make_unique<SJFScheduler>(true); },
+        [] { return std::make_unique<PriorityScheduler>(true); },
+        [] { return std::make_unique<PriorityScheduler>(false); },
+        [] { return std::make_unique<PriorityScheduler>(true, 3); },
+        [] { return std::make_unique<PriorityScheduler>(false, 3); },
+        [] { return std::make_unique<WorkStealingScheduler>(3); },
+        [] { return std::make_unique<CFSScheduler>(); },
+        [] { return std::make_unique<CFSScheduler>(20, 3); },
+        [] { return std::make_unique<MLFQScheduler>(3, 2, 30); },
+        [] { return std::make_unique<MLFQScheduler>(4, 1, 0); },
+    };
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> gap(0, 6), burst(1, 12), prio(0, 4);
+    std::vector<std::tuple<int, int, int>> workload;
+    for (int i = 0, at = 0; i < 200; i++) {
+        at += gap(rng);
+        workload.emplace_back(at, burst(rng), prio(rng));
+    }
+
+    for (const auto& make : factories) {
+        for (int overhead : {0, 1, 3}) {
+            for (int cpus : {1, 3}) {
+                Simulator tick(make(), overhead, SimulationMode::TICK, cpus);
+                Simulator event(make(), overhead, SimulationMode::EVENT_DRIVEN, cpus);
+                for (const auto& [at, bt, pr] : workload) {
+                    tick.add_process(at, bt, pr);
+                    event.add_process(at, bt, pr);
+                }
+                auto expected = tick.run();
+                auto actual = event.run();
+
+                SCOPED_TRACE(make()->name() + " overhead " + std::to_string(overhead) +
+                             " cpus " + std::to_string(cpus));
+                EXPECT_EQ(actual.completed_processes, expected.completed_processes);
+                EXPECT_EQ(actual.total_context_switches, expected.total_context_switches);
+                EXPECT_DOUBLE_EQ(actual.avg_waiting_time, expected.avg_waiting_time);
+                EXPECT_DOUBLE_EQ(actual.avg_turnaround_time, expected.avg_turnaround_time);
+                EXPECT_DOUBLE_EQ(actual.avg_response_time, expected.avg_response_time);
+                EXPECT_EQ(actual.waiting_times.percentile(99),
+                          expected.waiting_times.percentile(99));
+                EXPECT_EQ(actual.cpu_context_switches, expected.cpu_context_switches);
+                EXPECT_EQ(actual.cpu_utilization, expected.cpu_utilization);
+                EXPECT_EQ(event.current_time(), tick.current_time());
+            }
+        }
+    }
+}
+
+TEST_F(SchedulerTest, EventDrivenLongBursts) {
+    auto s = std::make_unique<RoundRobinScheduler>(1000);
+    Simulator sim(std::move(s), 0, SimulationMode::EVENT_DRIVEN);
+    sim.add_process(0, 200000000, 1);
+    sim.add_process(500000000, 300000000, 1);
+    stats = sim.run();
+
+    EXPECT_EQ(stats.completed_processes, 2);
+    EXPECT_EQ(stats.avg_waiting_time, 0);
+    EXPECT_EQ(stats.avg_turnaround_time, 250000000);
+}
+
+TEST_F(SchedulerTest, UnsortedArrivals) {
+    auto s = std::make_unique<FCFSScheduler>();
+    Simulator sim(std::move(s));
+
+    // Added out of order; admission must still follow arrival time
+    sim.add_process(10, 2, 1);
+    sim.add_process(0, 4, 1);
+    sim.add_process(3, 1, 1);
+    stats = sim.run();
+
+    EXPECT_EQ(stats.completed_processes, 3);
+    EXPECT_DOUBLE_EQ(stats.avg_waiting_time, 1.0 / 3);
+    EXPECT_EQ(sim.current_time(), 12);
+}
+
+TEST_F(SchedulerTest, PriorityTiesAreFIFO) {
+    auto s = std::make_unique<PriorityScheduler>(false);
+    Simulator sim(std::move(s));
+
+    // More than a small-sort's worth of equal priorities, longest first
+    const int n = 40;
+    double expected_wait = 0;
+    for (int i = 0, elapsed = 0; i < n; i++) {
+        sim.add_process(0, n - i, 1);
+        expected_wait += elapsed;
+        elapsed += n - i;
+    }
+    stats = sim.run();
+
+    EXPECT_EQ(stats.completed_processes, n);
+    EXPECT_DOUBLE_EQ(stats.avg_waiting_time, expected_wait / n);
+}
+
+TEST_F(SchedulerTest, PriorityAging) {
+    // A low-priority process queued behind a steady stream of high-priority ones
+    auto run = [](int aging_interval) {
+        Simulator sim(std::make_unique<PriorityScheduler>(false, aging_interval));
+        sim.add_process(0, 1, 5);
+        for (int i = 0; i < 50; i++) {
+            sim.add_process(2 * i, 2, 1);
+        }
+        return sim.run();
+    };
+
+    // Without aging it waits for the whole stream
+    auto starved = run(0);
+    EXPECT_EQ(starved.completed_processes, 51);
+    EXPECT_DOUBLE_EQ(starved.avg_waiting_time, 100.0 / 51);
+
+    // Gaining a level every 2 units, it overtakes the job that arrives at t=8; that job
+    // and every later one then wait 1
+    auto aged = run(2);
+    EXPECT_EQ(aged.completed_processes, 51);
+    EXPECT_DOUBLE_EQ(aged.avg_waiting_time, (8.0 + 46) / 51);
+}
+
+TEST_F(SchedulerTest, ResponseTime) {
+    auto s = std::make_unique<RoundRobinScheduler>(2);
+    Simulator sim(std::move(s));
+    sim.add_process(0, 4, 1);
+    sim.add_process(0, 4, 1);
+    sim.add_process(1, 1, 1);
+    stats = sim.run();
+
+    // P1 starts at 0, P2 at 2, P3 (arrived at 1) at 4
+    EXPECT_EQ(stats.completed_processes, 3);
+    EXPECT_DOUBLE_EQ(stats.avg_response_time, (0 + 2 + 3) / 3.0);
+}
+
+TEST_F(SchedulerTest, LatencyPercentiles) {
+    auto s = std::make_unique<FCFSScheduler>();
+    Simulator sim(std::move(s));
+    for (int i = 0; i < 100; i++) {
+        sim.add_process(0, 1, 1);
+    }
+    stats = sim.run();
+
+    // The i-th process waits i units
+    EXPECT_EQ(stats.waiting_times.count(), 100u);
+    EXPECT_EQ(stats.waiting_times.percentile(50), 49);
+    EXPECT_EQ(stats.waiting_times.percentile(90), 89);
+    EXPECT_EQ(stats.waiting_times.percentile(99), 98);
+    EXPECT_EQ(stats.waiting_times.max(), 99);
+    EXPECT_EQ(stats.turnaround_times.percentile(100), 100);
+    EXPECT_EQ(stats.response_times.percentile(50), 49);
+}
+
+TEST_F(SchedulerTest, LatencyHistogramPrecision) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> magnitude(0, 30);
+    std::vector<int> values;
+    LatencyHistogram histogram;
+    for (int i = 0; i < 10000; i++) {
+        int v = static_cast<int>(rng() % (1u << magnitude(rng)));
+        values.push_back(v);
+        histogram.record(v);
+    }
+    std::sort(values.begin(), values.end());
+
+    for (double p : {1.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100 * values.size()));
+        double exact = values[rank - 1];
+        EXPECT_GE(histogram.percentile(p), exact) << p;
+        EXPECT_LE(histogram.percentile(p), exact * (1 + 1.0 / 128)) << p;
+    }
+    EXPECT_EQ(histogram.max(), values.back());
+
+    LatencyHistogram empty;
+    EXPECT_EQ(empty.percentile(99), 0);
+    empty.merge(histogram);
+    EXPECT_EQ(empty.count(), histogram.count());
+    EXPECT_EQ(empty.percentile(90), histogram.percentile(90));
+}
+
+TEST_F(SchedulerTest, MultiCpu) {
+    // Four equal jobs on four CPUs run side by side
+    Simulator wide(std::make_unique<RoundRobinScheduler>(2), 0, SimulationMode::EVENT_DRIVEN, 4);
+    for (int i = 0; i < 4; i++) {
+        wide.add_process(0, 5, 1);
+    }
+    stats = wide.run();
+
+    EXPECT_EQ(stats.completed_processes, 4);
+    EXPECT_DOUBLE_EQ(stats.avg_waiting_time, 0);
+    EXPECT_EQ(stats.makespan, 5);
+    ASSERT_EQ(stats.cpu_utilization.size(), 4u);
+    for (int cpu = 0; cpu < 4; cpu++) {
+        EXPECT_DOUBLE_EQ(stats.cpu_utilization[cpu], 1.0);
+        // Each quantum expiry re-dispatches the same process: dispatch + 2 x (preempt + dispatch)
+        EXPECT_EQ(stats.cpu_context_switches[cpu], 5);
+    }
+
+    // A context switch stalls only its own CPU
+    Simulator stalled(std::make_unique<FCFSScheduler>(), 2, SimulationMode::EVENT_DRIVEN, 2);
+    stalled.add_process(0, 4, 1);
+    stalled.add_process(1, 4, 1);
+    stats = stalled.run();
+
+    EXPECT_EQ(stats.completed_processes, 2);
+    EXPECT_DOUBLE_EQ(stats.avg_response_time, 2);
+    EXPECT_EQ(stats.makespan, 7);
+    EXPECT_EQ(stats.cpu_context_switches, (std::vector<int>{1, 1}));
+
+    EXPECT_THROW(Simulator(std::make_unique<FCFSScheduler>(), 0, SimulationMode::TICK, 0),
+                 std::invalid_argument);
+}
+
+TEST_F(SchedulerTest, WorkStealing) {
+    // Arrivals alternate between the two run queues: A and C on CPU 0, B and D on CPU 1
+    Simulator sim(std::make_unique<WorkStealingScheduler>(100), 0,
+                  SimulationMode::EVENT_DRIVEN, 2);
+    sim.add_process(0, 1, 1);
+    sim.add_process(0, 10, 1);
+    sim.add_process(0, 1, 1);
+    sim.add_process(0, 10, 1);
+    stats = sim.run();
+
+    // CPU 0 drains its queue at t=2 and steals D rather than idling until B finishes
+    EXPECT_EQ(stats.completed_processes, 4);
+    EXPECT_EQ(stats.steals, 1);
+    EXPECT_EQ(stats.migrations, 0);
+    EXPECT_DOUBLE_EQ(stats.avg_response_time, (0 + 0 + 1 + 2) / 4.0);
+    EXPECT_EQ(stats.makespan, 12);
+
+    // Preempted processes stay on their CPU, unlike with a shared queue
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> burst(1, 20);
+    Workload workload;
+    for (int i = 0; i < 64; i++) {
+        workload.push_back({0, burst(rng), 1});
+    }
+    Simulator shared(std::make_unique<RoundRobinScheduler>(2), 0, SimulationMode::EVENT_DRIVEN, 4);
+    Simulator stealing(std::make_unique<WorkStealingScheduler>(2), 0,
+                       SimulationMode::EVENT_DRIVEN, 4);
+    shared.add_processes(workload);
+    stealing.add_processes(workload);
+    auto shared_stats = shared.run();
+    auto stealing_stats = stealing.run();
+
+    EXPECT_EQ(stealing_stats.completed_processes, 64);
+    EXPECT_GT(stealing_stats.steals, 0);
+    EXPECT_LT(stealing_stats.migrations, shared_stats.migrations);
+}
+
+TEST_F(SchedulerTest, CFS) {
+    // Equal weights split the 6-tick period into 3-tick slices
+    Simulator even(std::make_unique<CFSScheduler>(6, 1));
+    even.add_process(0, 6, 0);
+    even.add_process(0, 6, 0);
+    stats = even.run();
+
+    EXPECT_EQ(stats.completed_processes, 2);
+    EXPECT_DOUBLE_EQ(stats.avg_waiting_time, (3 + 6) / 2.0);
+    EXPECT_EQ(stats.total_context_switches, 6);
+
+    // Nice 0 outweighs nice 10 about 9:1, so it finishes long before the other
+    Simulator equal(std::make_unique<CFSScheduler>());
+    equal.add_process(0, 100, 0);
+    equal.add_process(0, 100, 0);
+    auto equal_stats = equal.run();
+    Simulator weighted(std::make_unique<CFSScheduler>());
+    weighted.add_process(0, 100, 0);
+    weighted.add_process(0, 100, 10);
+    auto weighted_stats = weighted.run();
+
+    EXPECT_GT(equal_stats.avg_turnaround_time, 190);
+    EXPECT_LT(weighted_stats.avg_turnaround_time, 160);
+
+    // A late arrival starts level with the running process instead of taking the CPU
+    // for as long as that one has already run
+    Simulator late(std::make_unique<CFSScheduler>(6, 1));
+    late.add_process(0, 1000, 0);
+    late.add_process(500, 1000, 0);
+    stats = late.run();
+
+    EXPECT_EQ(stats.completed_processes, 2);
+    EXPECT_LT(stats.total_context_switches, 1000);
+    EXPECT_GT(stats.total_context_switches, 200);
+
+    EXPECT_EQ(CFSScheduler::nice_to_weight(0), 1024u);
+    EXPECT_EQ(CFSScheduler::nice_to_weight(-40), 88761u);
+    EXPECT_EQ(CFSScheduler::nice_to_weight(40), 15u);
+}
+
+TEST_F(SchedulerTest, MLFQ) {
+    // A is demoted to level 2 by t=6; B arrives on level 0 at t=10 and preempts it at once
+    Simulator sim(std::make_unique<MLFQScheduler>(3, 2, 0));
+    sim.add_process(0, 20, 1);
+    sim.add_process(10, 1, 1);
+    stats = sim.run();
+
+    EXPECT_EQ(stats.completed_processes, 2);
+    EXPECT_DOUBLE_EQ(stats.avg_response_time, 0);
+    EXPECT_DOUBLE_EQ(stats.avg_waiting_time, 0.5);
+    EXPECT_EQ(stats.total_context_switches, 10);
+
+    // Quanta 1, 2, 4; boost every 10
+    ProcessTable table;
+    ProcessHandle a = table.add(1, 0, 100, 1);
+    ProcessHandle c = table.add(2, 0, 100, 1);
+    MLFQScheduler mlfq(3, 1, 10);
+    mlfq.attach(table);
+    mlfq.add_process(a);
+
+    ASSERT_EQ(mlfq.get_next_process(), a);
+    EXPECT_TRUE(mlfq.needs_preemption(a, 1));
+    mlfq.preempt_process(a);
+    EXPECT_EQ(mlfq.level(a), 1);
+
+    ASSERT_EQ(mlfq.get_next_process(), a);
+    EXPECT_FALSE(mlfq.needs_preemption(a, 2));
+    EXPECT_TRUE(mlfq.needs_preemption(a, 3));
+    mlfq.preempt_process(a);
+    EXPECT_EQ(mlfq.level(a), 2);
+
+    // The highest non-empty level wins regardless of queueing order
+    mlfq.add_process(c);
+    ASSERT_EQ(mlfq.get_next_process(), c);
+    mlfq.preempt_process(c);
+    EXPECT_EQ(mlfq.ready_queue_size(), 2u);
+    ASSERT_EQ(mlfq.get_next_process(), c);
+
+    // At the boost everything returns to level 0
+    EXPECT_TRUE(mlfq.needs_preemption(c, 10));
+    mlfq.preempt_process(c);
+    ASSERT_EQ(mlfq.get_next_process(), a);
+    EXPECT_EQ(mlfq.level(a), 0);
+}
+
+TEST_F(SchedulerTest, SRTF) {
+    // Textbook example: P2 preempts P1 at t=1, P4 runs before P1 resumes
+    Simulator sim(std::make_unique<SJFScheduler>(true));
+    sim.add_process(0, 8, 1);
+    sim.add_process(1, 4, 1);
+    sim.add_process(2, 9, 1);
+    sim.add_process(3, 5, 1);
+    stats = sim.run();
+
+    EXPECT_EQ(stats.completed_processes, 4);
+    EXPECT_DOUBLE_EQ(stats.avg_waiting_time, 6.5);
+    EXPECT_DOUBLE_EQ(stats.avg_response_time, (0 + 0 + 15 + 2) / 4.0);
+    EXPECT_EQ(stats.total_context_switches, 6);
+
+    // Non-preemptive SJF on the same workload lets P1 finish first
+    Simulator sjf(std::make_unique<SJFScheduler>());
+    sjf.add_process(0, 8, 1);
+    sjf.add_process(1, 4, 1);
+    sjf.add_process(2, 9, 1);
+    sjf.add_process(3, 5, 1);
+    EXPECT_DOUBLE_EQ(sjf.run().avg_waiting_time, 7.75);
+}
+
+TEST_F(SchedulerTest, SweepMatchesSingleRuns) {
+    Workload workload;
+    for (const auto& [at, bt, prio] : procs) {
+        workload.push_back({at, bt, prio});
+    }
+    auto grid = make_sweep_grid({"rr", "fcfs", "sjf", "prio"}, {1, 2, 4}, {0, 1});
+    ASSERT_EQ(grid.size(), 3u * 2 + 3 * 2);
+
+    auto results = run_sweep(workload, grid, 4);
+    ASSERT_EQ(results.size(), grid.size());
+    for (size_t i = 0; i < grid.size(); i++) {
+        const auto& point = grid[i];
+        Simulator sim(make_scheduler(point.algorithm, std::max(point.quantum, 1), true),
+                      point.context_switch_overhead);
+        sim.add_processes(workload);
+        auto expected = sim.run();
+
+        EXPECT_EQ(results[i].point.algorithm, point.algorithm);
+        EXPECT_EQ(results[i].stats.total_context_switches, expected.total_context_switches);
+        EXPECT_DOUBLE_EQ(results[i].stats.avg_waiting_time, expected.avg_waiting_time);
+    }
+
+    EXPECT_THROW(run_sweep(workload, make_sweep_grid({"bogus"}, {1}, {0})),
+                 std::invalid_argument);
+}
+
+TEST_F(SchedulerTest, ReadWorkloadSkipsMetadata) {
+    std::istringstream doc(R"({
+        "processes": [
+            {"arrival_time": 0, "burst_time": 8, "priority": 2, "description": "long"},
+            {"arrival_time": 3, "burst_time": 2, "priority": 1, "tags": [1, 2]}
+        ],
+        "metadata": {"priority_range": [1, 3], "total_processes": 2}
+    })");
+    Workload workload;
+    read_workload(doc, [&workload](const WorkloadEntry& e) { workload.push_back(e); });
+
+    ASSERT_EQ(workload.size(), 2u);
+    EXPECT_EQ(workload[1].arrival_time, 3);
+    EXPECT_EQ(workload[1].burst_time, 2);
+    EXPECT_EQ(workload[1].priority, 1);
+
+    std::istringstream missing(R"({"processes": [{"arrival_time": 0, "burst_time": 1}]})");
+    EXPECT_THROW(read_workload(missing, [](const WorkloadEntry&) {}), std::runtime_error);
+}
+
+TEST_F(SchedulerTest, StreamedMatchesPreloaded) {
+    std::string lines;
+    for (const auto& [at, bt, prio] : procs) {
+        lines += "{\"arrival_time\": " + std::to_string(at) + ", \"burst_time\": " +
+                 std::to_string(bt) + ", \"priority\": " + std::to_string(prio) + "}\n";
+    }
+
+    Simulator preloaded(std::make_unique<RoundRobinScheduler>(2), 1);
+    run_sim(preloaded);
+
+    Simulator streamed(std::make_unique<RoundRobinScheduler>(2), 1);
+    streamed.set_process_source(
+        std::make_unique<JsonLinesSource>(std::make_unique<std::istringstream>(lines)));
+    auto actual = streamed.run();
+
+    EXPECT_EQ(actual.completed_processes, stats.completed_processes);
+    EXPECT_EQ(actual.total_context_switches, stats.total_context_switches);
+    EXPECT_DOUBLE_EQ(actual.avg_waiting_time, stats.avg_waiting_time);
+    EXPECT_DOUBLE_EQ(actual.avg_response_time, stats.avg_response_time);
+
+    Simulator unsorted(std::make_unique<FCFSScheduler>());
+    unsorted.set_process_source(std::make_unique<JsonLinesSource>(
+        std::make_unique<std::istringstream>(
+            "{\"arrival_time\": 5, \"burst_time\": 1, \"priority\": 0}\n"
+            "{\"arrival_time\": 2, \"burst_time\": 1, \"priority\": 0}\n")));
+    EXPECT_THROW(unsorted.run(), std::runtime_error);
+}
+
+TEST_F(SchedulerTest, ReadScenario) {
+    std::istringstream doc(R"({
+        "light": {"description": "x", "processes": [{"arrival_time": 0, "burst_time": 1, "priority": 0}]},
+        "heavy": {"processes": [
+            {"arrival_time": 0, "burst_time": 9, "priority": 1},
+            {"arrival_time": 4, "burst_time": 7, "priority": 2}
+        ]}
+    })");
+    Workload workload;
+    read_workload(doc, [&workload](const WorkloadEntry& e) { workload.push_back(e); }, "heavy");
+
+    ASSERT_EQ(workload.size(), 2u);
+    EXPECT_EQ(workload[0].burst_time, 9);
+    EXPECT_EQ(workload[1].arrival_time, 4);
+
+    doc.clear();
+    doc.seekg(0);
+    EXPECT_THROW(read_workload(doc, [](const WorkloadEntry&) {}, "missing"), std::runtime_error);
+}
+
+TEST_F(SchedulerTest, BinaryTraceMatchesPreloaded) {
+    const std::string path = testing::TempDir() + "scheduler_test_trace.bin";
+    // Written out of order; the converter sorts by arrival
+    write_binary_trace(path, {{6, 2, 3}, {0, 5, 1}, {4, 4, 1}, {2, 3, 2}});
+    ASSERT_TRUE(is_binary_trace(path));
+    {
+        MappedTrace trace(path);
+        ASSERT_EQ(trace.size(), 4u);
+        EXPECT_EQ(trace.records()[0].burst_time, 5);
+        EXPECT_EQ(trace.records()[3].arrival_time, 6);
+    }
+
+    Simulator preloaded(std::make_unique<RoundRobinScheduler>(2), 1);
+    run_sim(preloaded);
+
+    Simulator mapped(std::make_unique<RoundRobinScheduler>(2), 1);
+    mapped.set_process_source(std::make_unique<BinaryTraceSource>(path));
+    auto actual = mapped.run();
+
+    EXPECT_EQ(actual.completed_processes, stats.completed_processes);
+    EXPECT_EQ(actual.total_context_switches, stats.total_context_switches);
+    EXPECT_DOUBLE_EQ(actual.avg_waiting_time, stats.avg_waiting_time);
+    EXPECT_DOUBLE_EQ(actual.avg_response_time, stats.avg_response_time);
+
+    // A trace from a big-endian host is rejected rather than read with swapped fields
+    {
+        std::fstream swapped(path, std::ios::binary | std::ios::in | std::ios::out);
+        swapped.seekp(offsetof(BinaryTraceHeader, version));
+        const char big_endian_version[4] = {0, 0, 0, 1};
+        swapped.write(big_endian_version, sizeof(big_endian_version));
+    }
+    try {
+        MappedTrace trace(path);
+        ADD_FAILURE() << "byte-swapped trace was accepted";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("big-endian"), std::string::npos);
+    }
+    write_binary_trace(path, {{0, 5, 1}});
+
+    // A truncated file is rejected instead of read past its end
+    {
+        std::ofstream truncated(path, std::ios::binary | std::ios::in | std::ios::out);
+        truncated.seekp(16);
+        uint64_t count = 1000;
+        truncated.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    EXPECT_THROW(MappedTrace{path}, std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_FALSE(is_binary_trace(path));
+}
+
+TEST_F(SchedulerTest, EventTrace) {
+    MemoryTraceSink sink;
+    EventRecorder recorder(sink, 3);  // Small chunks so the run flushes several times
+    Simulator sim(std::make_unique<RoundRobinScheduler>(2), 1);
+    sim.set_event_recorder(&recorder);
+    run_sim(sim);
+
+    const auto& events = sink.events();
+    ASSERT_EQ(events.size(), recorder.recorded());
+    EXPECT_EQ(events[0].kind, TraceEventKind::ARRIVE);
+    EXPECT_EQ(events[0].pid, 1);
+    EXPECT_EQ(events[0].cpu, -1);
+    // The first dispatch pays the switch overhead before it starts
+    EXPECT_EQ(events[1].kind, TraceEventKind::START);
+    EXPECT_EQ(events[1].time, 1);
+    EXPECT_EQ(events[1].cpu, 0);
+
+    std::map<int, std::array<int, 4>> per_pid;
+    for (const auto& e : events) {
+        per_pid[e.pid][static_cast<int>(e.kind)]++;
+    }
+    int switches = 0;
+    for (const auto& [pid, counts] : per_pid) {
+        SCOPED_TRACE(pid);
+        EXPECT_EQ(counts[static_cast<int>(TraceEventKind::ARRIVE)], 1);
+        EXPECT_EQ(counts[static_cast<int>(TraceEventKind::COMPLETE)], 1);
+        EXPECT_EQ(counts[static_cast<int>(TraceEventKind::START)],
+                  counts[static_cast<int>(TraceEventKind::PREEMPT)] + 1);
+        switches += counts[static_cast<int>(TraceEventKind::START)] +
+                    counts[static_cast<int>(TraceEventKind::PREEMPT)];
+    }
+    EXPECT_EQ(per_pid.size(), procs.size());
+    EXPECT_EQ(switches, stats.total_context_switches);
+}
+
+TEST_F(SchedulerTest, EventTraceRejectsCpusPastTheRecord) {
+    MemoryTraceSink sink;
+    EventRecorder recorder(sink);
+    // The highest CPU index still fits the 16-bit field, one more would wrap negative
+    Simulator widest(std::make_unique<FCFSScheduler>(), 0, SimulationMode::EVENT_DRIVEN,
+                     kMaxEventTraceCpus);
+    EXPECT_NO_THROW(widest.set_event_recorder(&recorder));
+    Simulator too_wide(std::make_unique<FCFSScheduler>(), 0, SimulationMode::EVENT_DRIVEN,
+                       kMaxEventTraceCpus + 1);
+    EXPECT_THROW(too_wide.set_event_recorder(&recorder), std::invalid_argument);
+    EXPECT_NO_THROW(too_wide.set_event_recorder(nullptr));
+}
+
+TEST_F(SchedulerTest, EventTraceMatchesTickAndFile) {
+    std::mt19937 rng(11);
+    std::vector<std::tuple<int, int, int>> workload;
+    for (int i = 0; i < 60; i++) {
+        workload.emplace_back(rng() % 80, 1 + rng() % 15, rng() % 5);
+    }
+    const std::string path = testing::TempDir() + "scheduler_test_events.bin";
+
+    for (int overhead : {0, 2}) {
+        MemoryTraceSink tick_sink;
+        EventRecorder tick_recorder(tick_sink);
+        Simulator tick(std::make_unique<MLFQScheduler>(3, 2, 30), overhead,
+                       SimulationMode::TICK, 3);
+        tick.set_event_recorder(&tick_recorder);
+
+        {
+            BinaryEventTraceWriter writer(path);
+            EventRecorder recorder(writer, 16);
+            Simulator event(std::make_unique<MLFQScheduler>(3, 2, 30), overhead,
+                            SimulationMode::EVENT_DRIVEN, 3);
+            event.set_event_recorder(&recorder);
+            for (const auto& [at, bt, pr] : workload) {
+                tick.add_process(at, bt, pr);
+                event.add_process(at, bt, pr);
+            }
+            tick.run();
+            event.run();
+        }
+
+        auto from_file = read_event_trace(path);
+        const auto& expected = tick_sink.events();
+        ASSERT_EQ(from_file.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            SCOPED_TRACE(i);
+            EXPECT_EQ(from_file[i].time, expected[i].time);
+            EXPECT_EQ(from_file[i].pid, expected[i].pid);
+            EXPECT_EQ(from_file[i].cpu, expected[i].cpu);
+            EXPECT_EQ(from_file[i].kind, expected[i].kind);
+        }
+    }
+
+    // A header claiming more events than the file holds is refused before any allocation
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        BinaryTraceHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.record_count = uint64_t{1} << 60;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    EXPECT_THROW(read_event_trace(path), std::runtime_error);
+
+    std::remove(path.c_str());
+    EXPECT_THROW(read_event_trace(path), std::runtime_error);
+}
+
+TEST_F(SchedulerTest, ChromeTrace) {
+    for (auto tracks : {ChromeTraceTracks::CPU, ChromeTraceTracks::PROCESS}) {
+        std::stringstream out;
+        {
+            ChromeTraceWriter writer(out, tracks, 1000);
+            EventRecorder recorder(writer, 4);
+            Simulator sim(std::make_unique<RoundRobinScheduler>(2), 1,
+                          SimulationMode::EVENT_DRIVEN, 2);
+            sim.set_event_recorder(&recorder);
+            run_sim(sim);
+        }
+
+        auto trace = nlohmann::json::parse(out.str());
+        std::map<int, long long> run_time;  // By simulated pid
+        std::map<int, std::string> row_names;
+        int arrivals = 0;
+        for (const auto& event : trace["traceEvents"]) {
+            std::string phase = event["ph"];
+            if (phase == "X") {
+                run_time[event["args"]["pid"].get<int>()] += event["dur"].get<long long>();
+            } else if (phase == "i") {
+                arrivals++;
+            } else if (phase == "M" && event["name"] == "thread_name") {
+                row_names[event["tid"].get<int>()] = event["args"]["name"];
+            }
+        }
+
+        // Every unit of every burst shows up as run time, in microseconds
+        EXPECT_EQ(arrivals, 4);
+        ASSERT_EQ(run_time.size(), procs.size());
+        for (size_t i = 0; i < procs.size(); i++) {
+            EXPECT_EQ(run_time[static_cast<int>(i) + 1], std::get<1>(procs[i]) * 1000LL);
+        }
+        if (tracks == ChromeTraceTracks::CPU) {
+            EXPECT_EQ(row_names[-1], "Arrivals");
+            EXPECT_EQ(row_names[0], "CPU 0");
+            EXPECT_EQ(row_names[1], "CPU 1");
+        } else {
+            EXPECT_EQ(row_names.size(), procs.size());
+            EXPECT_EQ(row_names[3], "P3");
+        }
+    }
+}
+
+
+TEST_F(SchedulerTest, ChromeTraceSkipsStartsOnNoCpu) {
+    // Events from a sink other than the simulator may carry any CPU
+    const TraceEvent events[] = {
+        {0, 1, -1, TraceEventKind::ARRIVE, 0},
+        {1, 1, -5, TraceEventKind::START, 0},
+        {2, 1, -5, TraceEventKind::PREEMPT, 0},
+        {2, 1, 3, TraceEventKind::START, 0},
+        {5, 1, 3, TraceEventKind::COMPLETE, 0},
+    };
+    std::stringstream out;
+    {
+        ChromeTraceWriter writer(out, ChromeTraceTracks::CPU, 1);
+        writer.write(events, std::size(events));
+    }
+
+    auto trace = nlohmann::json::parse(out.str());
+    int slices = 0;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X") {
+            slices++;
+            EXPECT_EQ(event["tid"], 3);
+            EXPECT_EQ(event["dur"], 3);
+        }
+    }
+    EXPECT_EQ(slices, 1);
+}
+TEST_F(SchedulerTest, FtraceReplay) {
+    const std::string path = testing::TempDir() + "scheduler_test_ftrace.txt";
+    {
+        std::ofstream out(path);
+        out << "# tracer: nop\n"
+               "#\n"
+               "  <idle>-0 [000] dNh2. 100.000100: sched_wakeup: comm=sshd pid=890 prio=120 target_cpu=000\n"
+               "  <idle>-0 [000] d..2. 100.000150: sched_switch: prev_comm=swapper/0 prev_pid=0 prev_prio=120 prev_state=R ==> next_comm=sshd next_pid=890 next_prio=120\n"
+               "  sshd-890 [000] d..3. 100.000420: sched_wakeup_new: comm=make pid=12 prio=125 target_cpu=001\n"
+               "  <idle>-0 [001] d..2. 100.000460: sched_switch: prev_comm=swapper/1 prev_pid=0 prev_prio=120 prev_state=R ==> next_comm=make next_pid=12 next_prio=125\n"
+               // Preempted while runnable: the burst goes on
+               "  make-12  [001] d..2. 100.000600: sched_switch: prev_comm=make prev_pid=12 prev_prio=125 prev_state=R+ ==> next_comm=kworker/1:0 next_pid=57 next_prio=100\n"
+               "  kworker/1:0-57 [001] d..2. 100.000700: sched_switch: prev_comm=kworker/1:0 prev_pid=57 prev_prio=100 prev_state=I ==> next_comm=make next_pid=12 next_prio=125\n"
+               // perf sched script puts the pid in its own column and prefixes the event
+               "  make 12 [001] 100.000900: sched:sched_switch: prev_comm=make prev_pid=12 prev_prio=125 prev_state=D ==> next_comm=swapper/1 next_pid=0 next_prio=120\n"
+               // sshd sleeps after make has finished, but arrived first so is emitted first
+               "  sshd-890 [000] d..2. 100.002150: sched_switch: prev_comm=sshd prev_pid=890 prev_prio=120 prev_state=S ==> next_comm=swapper/0 next_pid=0 next_prio=120\n"
+               "  <idle> 0 [000] 100.003000: sched:sched_wakeup: comm=sshd pid=890 prio=120 target_cpu=000\n"
+               "  <idle> 0 [000] 100.003010: sched:sched_switch: prev_comm=swapper/0 prev_pid=0 prev_prio=120 prev_state=R ==> next_comm=sshd next_pid=890 next_prio=120\n"
+               "  not a scheduler event\n"
+               "  <idle>-0 [001] d..2. 100.003100: sched_switch: prev_comm=swapper/1 prev_pid=0 prev_prio=120 prev_state=R ==> next_comm=bash next_pid=3 next_prio=120\n";
+    }
+    ASSERT_TRUE(is_ftrace(path));
+
+    FtraceSource source(path, 10);
+    Workload bursts;
+    for (WorkloadEntry entry; source.next(entry);) {
+        bursts.push_back(entry);
+    }
+    EXPECT_EQ(source.events_parsed(), 11u);
+
+    // Times are relative to the first event, in units of 10us. kworker ran before the trace
+    // showed it waking, so its switch-in counts as the arrival. The second sshd burst is
+    // cut off by the end of the trace, and bash, switched in by the last event, never ran.
+    ASSERT_EQ(bursts.size(), 4u);
+    EXPECT_EQ(bursts[0].arrival_time, 0);    // sshd: 150..2150
+    EXPECT_EQ(bursts[0].burst_time, 200);
+    EXPECT_EQ(bursts[0].priority, 0);
+    EXPECT_EQ(bursts[1].arrival_time, 32);   // make: 460..600 and 700..900
+    EXPECT_EQ(bursts[1].burst_time, 34);
+    EXPECT_EQ(bursts[1].priority, 5);
+    EXPECT_EQ(bursts[2].arrival_time, 50);   // kworker: 600..700
+    EXPECT_EQ(bursts[2].burst_time, 10);
+    EXPECT_EQ(bursts[2].priority, -20);
+    EXPECT_EQ(bursts[3].arrival_time, 290);  // sshd again: 3010..3100
+    EXPECT_EQ(bursts[3].burst_time, 9);
+
+    Simulator sim(std::make_unique<CFSScheduler>(), 0, SimulationMode::EVENT_DRIVEN, 2);
+    sim.set_process_source(std::make_unique<FtraceSource>(path, 10));
+    stats = sim.run();
+    EXPECT_EQ(stats.completed_processes, 4);
+    std::remove(path.c_str());
+}
+
+TEST_F(SchedulerTest, FtraceTaskThatNeverSleeps) {
+    // A CPU-bound task (prio 130) is only ever preempted, never sleeps, while short tasks
+    // (prio 120) wake, run 20us and sleep, one every 100us
+    const std::string path = testing::TempDir() + "scheduler_test_ftrace_hog.txt";
+    const int cycles = 20000;
+    auto stamp = [](long long us) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%lld.%06lld", 10 + us / 1000000, us % 1000000);
+        return std::string(text);
+    };
+    {
+        std::ofstream out(path);
+        out << "  <idle>-0 [000] d..2. " << stamp(0) << ": sched_switch: prev_comm=swapper/0 prev_pid=0 prev_prio=120 prev_state=R ==> next_comm=hog next_pid=100 next_prio=130\n";
+        for (int i = 0; i < cycles; i++) {
+            int pid = 1000 + i % 1000;
+            long long t = 100LL * i + 80;
+            out << "  hog-100 [000] d..3. " << stamp(t) << ": sched_wakeup: comm=w pid=" << pid << " prio=120 target_cpu=000\n"
+                << "  hog-100 [000] d..2. " << stamp(t) << ": sched_switch: prev_comm=hog prev_pid=100 prev_prio=130 prev_state=R+ ==> next_comm=w next_pid=" << pid << " next_prio=120\n"
+                << "  w-" << pid << " [000] d..2. " << stamp(t + 20) << ": sched_switch: prev_comm=w prev_pid=" << pid << " prev_prio=120 prev_state=S ==> next_comm=hog next_pid=100 next_prio=130\n";
+        }
+        // Two tasks arrive together and are cut off by the end of the trace
+        long long end = 100LL * cycles + 10;
+        out << "  <idle>-0 [001] d..2. " << stamp(end) << ": sched_switch: prev_comm=swapper/1 prev_pid=0 prev_prio=120 prev_state=R ==> next_comm=b next_pid=9 next_prio=122\n"
+            << "  <idle>-0 [002] d..2. " << stamp(end) << ": sched_switch: prev_comm=swapper/2 prev_pid=0 prev_prio=120 prev_state=R ==> next_comm=a next_pid=5 next_prio=121\n"
+            << "  <idle>-0 [003] d..3. " << stamp(end + 30) << ": sched_wakeup: comm=c pid=7 prio=120 target_cpu=003\n";
+    }
+
+    for (long long split_after_us : {10000LL, 0LL}) {
+        SCOPED_TRACE(split_after_us);
+        FtraceSource source(path, 1, split_after_us);
+        Workload bursts;
+        size_t most_buffered = 0;
+        for (WorkloadEntry entry; source.next(entry);) {
+            bursts.push_back(entry);
+            most_buffered = std::max(most_buffered, source.buffered());
+        }
+
+        EXPECT_TRUE(std::is_sorted(bursts.begin(), bursts.end(),
+            [](const auto& a, const auto& b) { return a.arrival_time < b.arrival_time; }));
+        long long hog_time = 0;
+        int short_tasks = 0;
+        for (const auto& burst : bursts) {
+            if (burst.priority == 10) {
+                hog_time += burst.burst_time;
+            } else if (burst.priority == 0) {
+                EXPECT_EQ(burst.burst_time, 20);
+                short_tasks++;
+            }
+        }
+        EXPECT_EQ(short_tasks, cycles);
+        EXPECT_EQ(hog_time, 80LL * cycles + 40);
+
+        // Equal arrivals at the end come out by pid, whatever the hash order
+        ASSERT_GE(bursts.size(), 2u);
+        EXPECT_EQ(bursts[bursts.size() - 2].priority, 1);
+        EXPECT_EQ(bursts.back().priority, 2);
+
+        if (split_after_us > 0) {
+            // Cut every 10ms: only the bursts of about one horizon wait for the hog
+            EXPECT_LE(most_buffered, 200u);
+            EXPECT_GE(bursts.size(), static_cast<size_t>(cycles + 200));
+        } else {
+            // Never cut: every short burst waits behind the hog's first arrival
+            EXPECT_GE(most_buffered, static_cast<size_t>(cycles));
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST_F(SchedulerTest, WorkloadGenerator) {
+    GeneratorOptions options;
+    options.count = 200000;
+    options.seed = 42;
+    options.arrival_rate = 0.5;
+    options.mean_burst = 10;
+    options.priority_mix = {{0, 3.0}, {5, 1.0}};
+
+    auto mean_burst = [](const Workload& w) {
+        double total = 0;
+        for (const auto& e : w) {
+            total += e.burst_time;
+        }
+        return total / w.size();
+    };
+
+    for (auto arrivals : {ArrivalModel::POISSON, ArrivalModel::BURSTY}) {
+        for (auto bursts : {BurstModel::EXPONENTIAL, BurstModel::PARETO, BurstModel::BIMODAL}) {
+            options.arrivals = arrivals;
+            options.bursts = bursts;
+            options.pareto_shape = 3;  // Finite variance, so the sample mean settles
+            auto workload = generate_workload(options);
+            SCOPED_TRACE(static_cast<int>(arrivals) * 10 + static_cast<int>(bursts));
+
+            ASSERT_EQ(workload.size(), options.count);
+            EXPECT_EQ(workload.front().arrival_time, 0);
+            EXPECT_TRUE(std::is_sorted(workload.begin(), workload.end(),
+                [](const auto& a, const auto& b) { return a.arrival_time < b.arrival_time; }));
+            EXPECT_NEAR(mean_burst(workload), 10, 0.5);
+            EXPECT_NEAR(workload.back().arrival_time / static_cast<double>(options.count), 2, 0.1);
+
+            auto low = std::count_if(workload.begin(), workload.end(),
+                [](const auto& e) { return e.priority == 0; });
+            EXPECT_NEAR(low / static_cast<double>(options.count), 0.75, 0.01);
+        }
+    }
+
+    // Same seed, same workload; another seed, another workload
+    options.count = 100;
+    auto a = generate_workload(options);
+    auto b = generate_workload(options);
+    options.seed = 43;
+    auto c = generate_workload(options);
+    auto same = [](const Workload& x, const Workload& y) {
+        return std::equal(x.begin(), x.end(), y.begin(), [](const auto& p, const auto& q) {
+            return p.arrival_time == q.arrival_time && p.burst_time == q.burst_time &&
+                   p.priority == q.priority;
+        });
+    };
+    EXPECT_TRUE(same(a, b));
+    EXPECT_FALSE(same(a, c));
+
+    // Streamed straight into the simulator, identical to loading it up front
+    options.count = 5000;
+    Simulator streamed(std::make_unique<RoundRobinScheduler>(4), 0,
+                       SimulationMode::EVENT_DRIVEN, 4);
+    streamed.set_process_source(std::make_unique<WorkloadGenerator>(options));
+    auto actual = streamed.run();
+    Simulator preloaded(std::make_unique<RoundRobinScheduler>(4), 0,
+                        SimulationMode::EVENT_DRIVEN, 4);
+    preloaded.add_processes(generate_workload(options));
+    auto expected = preloaded.run();
+    EXPECT_EQ(actual.completed_processes, 5000);
+    EXPECT_DOUBLE_EQ(actual.avg_waiting_time, expected.avg_waiting_time);
+
+    options.pareto_shape = 1;
+    options.bursts = BurstModel::PARETO;
+    EXPECT_THROW(WorkloadGenerator{options}, std::invalid_argument);
+}
+
+TEST_F(SchedulerTest, StreamedRunReusesProcessRows) {
+    GeneratorOptions options;
+    options.arrival_rate = 0.25;  // Half the capacity of four CPUs, so no backlog builds
+    options.priority_mix = {{0, 1.0}, {1, 1.0}, {2, 1.0}};
+
+    // Rows of finished processes are reused, so the table only holds the live ones
+    options.count = 200000;
+    Simulator long_run(make_scheduler("cfs", 4, true), 0, SimulationMode::EVENT_DRIVEN, 4);
+    long_run.set_process_source(std::make_unique<WorkloadGenerator>(options));
+    auto long_stats = long_run.run();
+    EXPECT_EQ(long_stats.completed_processes, 200000);
+    EXPECT_LT(long_run.process_table_size(), 1000u);
+
+    // Reused rows and handles start clean in every scheduler
+    options.count = 10000;
+    for (const char* algorithm : {"rr", "fcfs", "sjf", "srtf", "prio", "ws", "cfs", "mlfq"}) {
+        SCOPED_TRACE(algorithm);
+        Simulator streamed(make_scheduler(algorithm, 4, true), 1,
+                           SimulationMode::EVENT_DRIVEN, 4);
+        streamed.set_process_source(std::make_unique<WorkloadGenerator>(options));
+        auto actual = streamed.run();
+        Simulator preloaded(make_scheduler(algorithm, 4, true), 1,
+                            SimulationMode::EVENT_DRIVEN, 4);
+        preloaded.add_processes(generate_workload(options));
+        auto expected = preloaded.run();
+        EXPECT_LT(streamed.process_table_size(), preloaded.process_table_size());
+        EXPECT_EQ(actual.completed_processes, expected.completed_processes);
+        EXPECT_EQ(actual.total_context_switches, expected.total_context_switches);
+        EXPECT_DOUBLE_EQ(actual.avg_waiting_time, expected.avg_waiting_time);
+        EXPECT_DOUBLE_EQ(actual.avg_response_time, expected.avg_response_time);
+        EXPECT_EQ(actual.waiting_times.percentile(99), expected.waiting_times.percentile(99));
+    }
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();